@@ -0,0 +1,552 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Accuracy Test
+
+    固定の信号コーパスを凍結した従来処理（VT2BGoldenReference）と DSP チェーン
+    （VT2BGlueEngine）の各経路に通し、出力の差を比べる。
+
+      経路:     reference（Scalar + Reference 精度、ビット一致を要求）/
+                scalar（Fast + 伝達関数表）/ scalar-analytic（Fast、表なし）/
+                実行できる SIMD レベル（sse2 / avx2 / avx512 / neon）
+      コーパス: 正弦波・スイープ・雑音・トランジェントのバースト・フルスケール・
+                ±2.0 超・デノーマル域・オーバーフロー手前、Drive / Mix のオートメーション
+      チャンネル: モノ / ステレオ（L と R は別の信号）
+
+    各組み合わせについて最大絶対誤差・RMS 誤差・ヌル深度（誤差 RMS / 基準 RMS、dB）を出し、
+    許容値を超えたものを列挙して終了コード 1 を返す。ホストのブロック長は
+    1〜512 の不規則な並びにし、短いブロックとサブブロック分割の両方を通す。
+
+    各経路で NaN / ±Inf を 1 サンプル入れたときの復帰（出力が有限のまま、
+    他チャンネルは変わらず、0.5 秒後にはきれいな入力と同じ出力に戻る）も確かめる。
+
+    使い方: VT2BAccuracyTest [--filter 名前の一部]
+  ==============================================================================
+*/
+
+#include "VT2BGoldenReference.h"
+#include "dsp/VT2BGlueEngine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+namespace {
+constexpr double kSampleRate = 48000.0;
+constexpr int kLength = 48000; // 1 秒
+constexpr int kMaximumBlockSize = 512;
+constexpr double kTwoPi = 6.283185307179586;
+
+// ホストのブロック長（この順に繰り返す）
+const int kBlockSizes[] = {512, 1, 7, 64, 113, 3, 256, 2, 500, 65};
+
+void enableFlushToZero() {
+#if defined(__SSE__) || defined(_M_X64)
+  _mm_setcsr(_mm_getcsr() | 0x8040); // FTZ | DAZ
+#endif
+}
+
+//==============================================================================
+struct Parameters {
+  float drive;
+  float mix; // 0〜1
+};
+
+/** コーパスの 1 項目。信号はチャンネルごと、パラメータはブロックの先頭で読む */
+struct Case {
+  const char *name;
+  std::function<float(int channel, int index)> signal;
+  std::function<Parameters(double seconds)> parameters;
+};
+
+float getNoise(int channel, int index) {
+  // チャンネルと位置だけで決まる擬似乱数（-1〜1）
+  uint32_t x = (uint32_t)index * 2654435761u + (uint32_t)channel * 40503u + 1u;
+  x ^= x >> 15;
+  x *= 0x2c1b3c6du;
+  x ^= x >> 12;
+  x *= 0x297a2d39u;
+  x ^= x >> 15;
+  return (float)x * (2.0f / 4294967296.0f) - 1.0f;
+}
+
+float getSine(double frequency, int index) {
+  return (float)std::sin(kTwoPi * frequency * index / kSampleRate);
+}
+
+Parameters fixed(float drive, float mix = 1.0f) { return {drive, mix}; }
+
+std::vector<Case> getCorpus() {
+  std::vector<Case> corpus;
+
+  corpus.push_back({"sine-1k",
+                    [](int channel, int i) {
+                      return 0.5f * getSine(channel == 0 ? 1000.0 : 1250.0, i);
+                    },
+                    [](double) { return fixed(5.0f); }});
+
+  corpus.push_back({"sine-60-full-scale",
+                    [](int channel, int i) {
+                      return getSine(channel == 0 ? 60.0 : 90.0, i);
+                    },
+                    [](double) { return fixed(10.0f); }});
+
+  // 20 Hz → 20 kHz の対数スイープ
+  corpus.push_back({"sweep",
+                    [](int channel, int i) {
+                      const double duration = kLength / kSampleRate;
+                      const double rate = std::log(1000.0) / duration;
+                      const double t = i / kSampleRate;
+                      const double phase =
+                          kTwoPi * 20.0 * (std::exp(rate * t) - 1.0) / rate;
+                      return (channel == 0 ? 0.7f : 0.35f) *
+                             (float)std::sin(phase);
+                    },
+                    [](double) { return fixed(7.0f); }});
+
+  corpus.push_back({"noise",
+                    [](int channel, int i) {
+                      return 0.3f * getNoise(channel, i);
+                    },
+                    [](double) { return fixed(3.0f, 0.5f); }});
+
+  // 100 ms ごとの減衰する雑音バースト（下地は -40 dB）
+  corpus.push_back({"transient-bursts",
+                    [](int channel, int i) {
+                      const int position = (i + channel * 1200) % 4800;
+                      const float decay =
+                          (float)std::exp(-position / (0.004 * kSampleRate));
+                      return getNoise(channel, i) * (0.01f + 0.99f * decay);
+                    },
+                    [](double) { return fixed(8.0f); }});
+
+  // ±1 の矩形波と無音を 50 ms ごとに切り替える
+  corpus.push_back({"full-scale-square",
+                    [](int channel, int i) {
+                      if ((i / 2400) % 2 == 1)
+                        return 0.0f;
+                      return ((i + channel * 60) / 240) % 2 == 0 ? 1.0f
+                                                                : -1.0f;
+                    },
+                    [](double) { return fixed(10.0f); }});
+
+  // 伝達関数表の範囲（±2.0）を超える振幅
+  corpus.push_back({"over-range",
+                    [](int channel, int i) {
+                      return 4.0f * getSine(channel == 0 ? 110.0 : 170.0, i);
+                    },
+                    [](double) { return fixed(6.0f); }});
+
+  // デノーマル域（FTZ/DAZ 下では 0 として扱われる）
+  corpus.push_back({"denormal",
+                    [](int channel, int i) {
+                      return 1.0e-39f * getNoise(channel, i);
+                    },
+                    [](double) { return fixed(5.0f); }});
+
+  // オーバーフロー手前: Drive 10 で 3 次の倍音が FLT_MAX に届く手前の振幅
+  corpus.push_back({"near-overflow",
+                    [](int channel, int i) {
+                      return 2.0e12f * getSine(channel == 0 ? 440.0 : 660.0, i);
+                    },
+                    [](double) { return fixed(10.0f); }});
+
+  // Drive を 0 → 10 → 0 に連続的に動かす（常にランプ中）
+  corpus.push_back({"drive-sweep",
+                    [](int channel, int i) {
+                      return 0.6f * getSine(channel == 0 ? 220.0 : 330.0, i) +
+                             0.1f * getNoise(channel, i);
+                    },
+                    [](double seconds) {
+                      const double phase = seconds / (kLength / kSampleRate);
+                      return fixed((float)(10.0 * (1.0 - std::abs(
+                                                             2.0 * phase - 1.0))));
+                    }});
+
+  // Drive（0 / 10）と Mix（0 / 50 / 100%）を段階的に切り替える
+  corpus.push_back({"drive-steps",
+                    [](int channel, int i) {
+                      return 0.6f * getSine(channel == 0 ? 220.0 : 330.0, i) +
+                             0.1f * getNoise(channel, i);
+                    },
+                    [](double seconds) {
+                      const int driveStep = (int)(seconds / 0.1);
+                      const int mixStep = (int)(seconds / 0.07);
+                      return fixed(driveStep % 2 == 0 ? 0.0f : 10.0f,
+                                   (float)(mixStep % 3) * 0.5f);
+                    }});
+
+  return corpus;
+}
+
+//==============================================================================
+/** 比べる経路 */
+struct Path {
+  std::string name;
+  VT2BSimdLevel level;
+  VT2BCurvePrecision precision;
+  bool shapeTable;
+  bool exact; // 基準とのビット一致を要求する
+};
+
+std::vector<Path> getPaths() {
+  std::vector<Path> paths = {
+      {"reference", VT2BSimdLevel::Scalar, VT2BCurvePrecision::Reference, false,
+       true},
+      {"scalar", VT2BSimdLevel::Scalar, VT2BCurvePrecision::Fast, true, false},
+      {"scalar-analytic", VT2BSimdLevel::Scalar, VT2BCurvePrecision::Fast,
+       false, false},
+  };
+
+  for (const auto level : {VT2BSimdLevel::SSE2, VT2BSimdLevel::AVX2,
+                           VT2BSimdLevel::AVX512, VT2BSimdLevel::NEON})
+    if (VT2BCpuFeatures::isSupported(level))
+      paths.push_back({VT2BCpuFeatures::getName(level), level,
+                       VT2BCurvePrecision::Fast, true, false});
+
+  return paths;
+}
+
+//==============================================================================
+/**
+ * 許容値（Fast 経路）
+ *   最大絶対誤差: フルスケール（信号のピークがそれより大きければピーク）に対する比
+ *   ヌル深度: 基準の RMS がデノーマル域より大きいときだけ確認する
+ * 伝達関数表の誤差上限（Drive 10 で 6.9e-5）と |x|^2.5 の Fast 評価（約 1.4 ulp）に余裕を見た値。
+ */
+constexpr double kMaxRelativeError = 1.0e-4; // -80 dB
+constexpr double kMaxNullDepthDb = -100.0;
+
+struct Errors {
+  double maxAbsError = 0.0;
+  double rmsError = 0.0;
+  double nullDepthDb = -std::numeric_limits<double>::infinity();
+  double peak = 0.0;
+  double referenceRms = 0.0;
+  int unexpectedNonFinite = 0; // 基準が有限なのに有限でないサンプル
+  int excluded = 0;            // 基準が有限でない（比較しない）サンプル
+};
+
+using Buffer = std::vector<std::vector<float>>;
+
+Buffer makeInput(const Case &corpusCase, int numChannels) {
+  Buffer buffer((size_t)numChannels, std::vector<float>((size_t)kLength));
+
+  for (int channel = 0; channel < numChannels; ++channel)
+    for (int i = 0; i < kLength; ++i)
+      buffer[(size_t)channel][(size_t)i] = corpusCase.signal(channel, i);
+
+  return buffer;
+}
+
+/** ホストと同じくブロックの先頭でパラメータを渡しながら処理する */
+template <typename Processor>
+void render(Processor &&processBlock, const Case &corpusCase, Buffer &buffer) {
+  const int numChannels = (int)buffer.size();
+  std::vector<float *> pointers((size_t)numChannels);
+  size_t blockIndex = 0;
+
+  for (int position = 0; position < kLength;) {
+    const int blockSize =
+        std::min(kBlockSizes[blockIndex++ % std::size(kBlockSizes)],
+                 kLength - position);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+      pointers[(size_t)channel] = buffer[(size_t)channel].data() + position;
+
+    processBlock(corpusCase.parameters(position / kSampleRate),
+                 pointers.data(), numChannels, blockSize);
+    position += blockSize;
+  }
+}
+
+Buffer renderReference(const Case &corpusCase, int numChannels) {
+  auto buffer = makeInput(corpusCase, numChannels);
+
+  VT2BGoldenReference reference;
+  reference.prepare(kSampleRate, numChannels);
+
+  render(
+      [&](Parameters parameters, float *const *channels, int, int numSamples) {
+        reference.setDrive(parameters.drive);
+        reference.setMix(parameters.mix);
+        reference.process(channels, numSamples);
+      },
+      corpusCase, buffer);
+
+  return buffer;
+}
+
+Buffer renderEngine(const Path &path, const Case &corpusCase,
+                    int numChannels) {
+  auto buffer = makeInput(corpusCase, numChannels);
+
+  VT2BGlueEngine engine;
+  engine.setSimdLevel(path.level);
+  engine.setCurvePrecision(path.precision);
+  engine.setShapeTableEnabled(path.shapeTable);
+  engine.prepare(kSampleRate, kMaximumBlockSize, numChannels);
+
+  render(
+      [&](Parameters parameters, float *const *channels, int channelCount,
+          int numSamples) {
+        engine.setDrive(parameters.drive);
+        engine.setMix(parameters.mix);
+        engine.process(channels, channelCount, numSamples);
+      },
+      corpusCase, buffer);
+
+  return buffer;
+}
+
+Errors compare(const Buffer &reference, const Buffer &output) {
+  Errors errors;
+  double squaredError = 0.0;
+  double squaredReference = 0.0;
+  long compared = 0;
+
+  for (size_t channel = 0; channel < reference.size(); ++channel) {
+    for (size_t i = 0; i < reference[channel].size(); ++i) {
+      const double expected = reference[channel][i];
+      const double actual = output[channel][i];
+
+      if (!std::isfinite(expected)) {
+        ++errors.excluded;
+        continue;
+      }
+
+      if (!std::isfinite(actual)) {
+        ++errors.unexpectedNonFinite;
+        continue;
+      }
+
+      const double difference = std::abs(actual - expected);
+      errors.maxAbsError = std::max(errors.maxAbsError, difference);
+      errors.peak = std::max(errors.peak, std::abs(expected));
+      squaredError += difference * difference;
+      squaredReference += expected * expected;
+      ++compared;
+    }
+  }
+
+  if (compared > 0) {
+    errors.rmsError = std::sqrt(squaredError / (double)compared);
+    errors.referenceRms = std::sqrt(squaredReference / (double)compared);
+  }
+
+  if (errors.rmsError > 0.0)
+    errors.nullDepthDb =
+        errors.referenceRms > 0.0
+            ? 20.0 * std::log10(errors.rmsError / errors.referenceRms)
+            : std::numeric_limits<double>::infinity();
+
+  return errors;
+}
+
+bool isWithinTolerance(const Path &path, const Errors &errors) {
+  if (errors.unexpectedNonFinite > 0)
+    return false;
+
+  if (path.exact)
+    return errors.maxAbsError == 0.0;
+
+  const double scale = std::max(errors.peak, 1.0);
+
+  if (errors.maxAbsError > kMaxRelativeError * scale)
+    return false;
+
+  if (errors.referenceRms > (double)std::numeric_limits<float>::min() &&
+      errors.nullDepthDb > kMaxNullDepthDb)
+    return false;
+
+  return true;
+}
+
+//==============================================================================
+/**
+ * 非有限値からの復帰
+ * L チャンネルの途中の 1 サンプルを NaN / +Inf / -Inf にして（sine-1k）処理し、出力に
+ * 非有限値が出ないこと、R チャンネルはきれいな入力のときとビット一致すること、
+ * L チャンネルも kRecoverySeconds 後にはきれいな入力のときと許容値内に戻ることを
+ * 確かめる。きれいな入力では復帰が起きないことも確かめる。
+ */
+constexpr int kInjectionIndex = kLength / 4;
+constexpr double kRecoverySeconds = 0.5;
+
+struct Recovery {
+  int nonFinite = 0;
+  uint64_t events = 0;
+  uint64_t cleanEvents = 0;
+  bool otherChannelExact = true;
+  double recoveredError = 0.0; // kRecoverySeconds 以降の L の最大絶対誤差
+};
+
+Recovery checkRecovery(const Path &path, const Case &corpusCase,
+                       float injected) {
+  auto clean = makeInput(corpusCase, 2);
+  auto injectedBuffer = clean;
+  injectedBuffer[0][(size_t)kInjectionIndex] = injected;
+
+  Recovery recovery;
+
+  for (Buffer *buffer : {&clean, &injectedBuffer}) {
+    VT2BGlueEngine engine;
+    engine.setSimdLevel(path.level);
+    engine.setCurvePrecision(path.precision);
+    engine.setShapeTableEnabled(path.shapeTable);
+    engine.prepare(kSampleRate, kMaximumBlockSize, 2);
+
+    render(
+        [&](Parameters parameters, float *const *channels, int channelCount,
+            int numSamples) {
+          engine.setDrive(parameters.drive);
+          engine.setMix(parameters.mix);
+          engine.process(channels, channelCount, numSamples);
+        },
+        corpusCase, *buffer);
+
+    (buffer == &clean ? recovery.cleanEvents : recovery.events) =
+        engine.getNumNonFiniteEvents();
+  }
+
+  const int recovered =
+      kInjectionIndex + (int)(kRecoverySeconds * kSampleRate);
+
+  for (int i = 0; i < kLength; ++i) {
+    const float left = injectedBuffer[0][(size_t)i];
+    const float right = injectedBuffer[1][(size_t)i];
+    recovery.nonFinite += !std::isfinite(left) + !std::isfinite(right);
+    recovery.otherChannelExact &= right == clean[1][(size_t)i];
+
+    if (i >= recovered)
+      recovery.recoveredError =
+          std::max(recovery.recoveredError,
+                   (double)std::abs(left - clean[0][(size_t)i]));
+  }
+
+  return recovery;
+}
+
+std::string formatDb(double value) {
+  if (std::isinf(value))
+    return value < 0.0 ? "-inf" : "+inf";
+
+  char text[32];
+  std::snprintf(text, sizeof(text), "%.1f", value);
+  return text;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::string filter;
+
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+      filter = argv[++i];
+    } else {
+      std::fprintf(stderr, "usage: VT2BAccuracyTest [--filter substring]\n");
+      return 2;
+    }
+  }
+
+  enableFlushToZero();
+
+  const auto corpus = getCorpus();
+  const auto paths = getPaths();
+
+  std::printf("%-40s %12s %12s %9s\n", "case", "max abs err", "rms err",
+              "null dB");
+
+  int failures = 0;
+  int run = 0;
+
+  for (const auto &corpusCase : corpus) {
+    for (const int numChannels : {1, 2}) {
+      const auto reference = renderReference(corpusCase, numChannels);
+
+      for (const auto &path : paths) {
+        const std::string name = std::string(corpusCase.name) + "/" +
+                                 (numChannels == 1 ? "mono" : "stereo") +
+                                 "/" + path.name;
+
+        if (!filter.empty() && name.find(filter) == std::string::npos)
+          continue;
+
+        const auto errors =
+            compare(reference, renderEngine(path, corpusCase, numChannels));
+        const bool passed = isWithinTolerance(path, errors);
+
+        std::printf("%-40s %12.3g %12.3g %9s%s\n", name.c_str(),
+                    errors.maxAbsError, errors.rmsError,
+                    formatDb(errors.nullDepthDb).c_str(),
+                    passed ? "" : "  FAILED");
+
+        if (errors.unexpectedNonFinite > 0)
+          std::printf("  %d non-finite sample(s) where the reference is "
+                      "finite\n",
+                      errors.unexpectedNonFinite);
+
+        ++run;
+        failures += passed ? 0 : 1;
+      }
+    }
+  }
+
+  std::printf("%d of %d comparison(s) out of tolerance (max error %.0e of "
+              "full scale, null depth %.0f dB; reference path bit-exact)\n",
+              failures, run, kMaxRelativeError, kMaxNullDepthDb);
+
+  std::printf("\n%-40s %12s %12s %9s\n", "non-finite recovery", "recovered err",
+              "non-finite", "events");
+
+  int recoveryFailures = 0;
+
+  for (const auto &path : paths) {
+    const struct {
+      const char *name;
+      float value;
+    } injections[] = {{"nan", std::numeric_limits<float>::quiet_NaN()},
+                      {"+inf", std::numeric_limits<float>::infinity()},
+                      {"-inf", -std::numeric_limits<float>::infinity()}};
+
+    for (const auto &injection : injections) {
+      const std::string name =
+          std::string("recovery/") + injection.name + "/" + path.name;
+
+      if (!filter.empty() && name.find(filter) == std::string::npos)
+        continue;
+
+      const auto recovery =
+          checkRecovery(path, corpus.front(), injection.value);
+      const bool passed = recovery.nonFinite == 0 && recovery.events > 0 &&
+                          recovery.cleanEvents == 0 &&
+                          recovery.otherChannelExact &&
+                          recovery.recoveredError <= kMaxRelativeError;
+
+      std::printf("%-40s %12.3g %12d %9llu%s\n", name.c_str(),
+                  recovery.recoveredError, recovery.nonFinite,
+                  (unsigned long long)recovery.events,
+                  passed ? "" : "  FAILED");
+
+      if (!recovery.otherChannelExact)
+        std::printf("  the other channel changed\n");
+
+      recoveryFailures += passed ? 0 : 1;
+    }
+  }
+
+  return failures + recoveryFailures > 0 ? 1 : 0;
+}
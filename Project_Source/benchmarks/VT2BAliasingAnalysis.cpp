@@ -0,0 +1,516 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Aliasing Analysis
+
+    折り返し対策の設定（1x / ADAA / オーバーサンプリング）ごとに、正弦波の周波数と
+    Drive を振って DSP チェーン（VT2BGlueEngine）の出力を FFT で分析し、
+    処理コストと並べた表（CSV / JSON）を出す。ヘッドレスで動く。
+
+      高調波     ナイキスト未満の高調波（2 次・3 次は個別にも出す）と THD（基本波に対する dB）
+      折り返し   基本波・高調波・直流以外のビンのエネルギー（数値雑音を含む、dBFS）
+      THD+N      基本波と直流以外のすべて（基本波に対する dB）
+      コスト     ステレオ・512 サンプルブロック・Drive 5 での ns/sample（1 チャンネルあたり）
+
+    FFT 長に対して周期がちょうど整数になる周波数（奇数ビン）を使うので窓関数は要らない。
+    高調波と、ナイキストを超えて折り返した成分はすべてビンの中央に落ちる。
+    折り返しを基本波ではなくフルスケールに対して測るのは、ADAA の高域減衰（2 次はちょうど fs/3 で
+    基本波が消える）で比が見かけ上悪くならないようにするため。
+    設定ごとに最悪の折り返しとコストを比べ、他の設定に両方で負けないものを Pareto 最適とする。
+
+    使い方: VT2BAliasingAnalysis [--sample-rate Hz（既定 48000）]
+                                 [--csv 出力 CSV] [--json 出力 JSON]
+                                 [--seconds コスト計測の秒数（設定ごと、既定 0.2）]
+                                 [--filter 設定名に含む文字列]
+  ==============================================================================
+*/
+
+#include "dsp/VT2BGlueEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+namespace {
+constexpr int kFftOrder = 16;
+constexpr int kFftSize = 1 << kFftOrder;
+constexpr float kAmplitude = 0.7f;
+constexpr double kWarmupSeconds = 0.5; // スムージング・エンベロープ・フィルタの定常まで
+constexpr int kBlockSize = 512;
+constexpr int kNumRounds = 8;
+constexpr double kTwoPi = 6.283185307179586;
+
+const double kFrequencies[] = {100.0, 1000.0, 4000.0, 8600.0, 12000.0,
+                               16000.0};
+const float kDrives[] = {1.0f, 5.0f, 10.0f};
+
+/** 折り返し対策の設定 */
+struct Setting {
+  const char *name;
+  int oversamplingLog2;
+  VT2BOversamplingFilter filter;
+  VT2BAntialiasing antialiasing;
+};
+
+const Setting kSettings[] = {
+    {"1x", 0, VT2BOversamplingFilter::MinimumPhase, VT2BAntialiasing::Off},
+    {"adaa1", 0, VT2BOversamplingFilter::MinimumPhase, VT2BAntialiasing::ADAA1},
+    {"adaa2", 0, VT2BOversamplingFilter::MinimumPhase, VT2BAntialiasing::ADAA2},
+    {"2x-min", 1, VT2BOversamplingFilter::MinimumPhase, VT2BAntialiasing::Off},
+    {"4x-min", 2, VT2BOversamplingFilter::MinimumPhase, VT2BAntialiasing::Off},
+    {"8x-min", 3, VT2BOversamplingFilter::MinimumPhase, VT2BAntialiasing::Off},
+    {"2x-lin", 1, VT2BOversamplingFilter::LinearPhase, VT2BAntialiasing::Off},
+    {"4x-lin", 2, VT2BOversamplingFilter::LinearPhase, VT2BAntialiasing::Off},
+    {"8x-lin", 3, VT2BOversamplingFilter::LinearPhase, VT2BAntialiasing::Off},
+    {"2x-min+adaa1", 1, VT2BOversamplingFilter::MinimumPhase,
+     VT2BAntialiasing::ADAA1},
+    {"2x-min+adaa2", 1, VT2BOversamplingFilter::MinimumPhase,
+     VT2BAntialiasing::ADAA2},
+};
+
+struct Options {
+  double sampleRate = 48000.0;
+  double seconds = 0.2;
+  std::string csvPath;
+  std::string jsonPath;
+  std::string filter;
+};
+
+/** 1 つの正弦波・Drive での分析結果（dBFS 以外は基本波に対する dB） */
+struct Measurement {
+  double frequency;
+  float drive;
+  double fundamentalDb; // dBFS
+  double harmonic2Db;   // ナイキスト以上なら NaN
+  double harmonic3Db;
+  double thdDb;
+  double aliasingDbfs;
+  double thdnDb;
+};
+
+struct SettingResult {
+  const Setting *setting;
+  int latencySamples;
+  double nsPerSample;
+  std::vector<Measurement> measurements;
+  double worstAliasingDbfs;
+  double worstThdnDb;
+  bool paretoOptimal;
+};
+
+void enableFlushToZero() {
+#if defined(__SSE__) || defined(_M_X64)
+  _mm_setcsr(_mm_getcsr() | 0x8040); // FTZ | DAZ
+#endif
+}
+
+void prepareEngine(VT2BGlueEngine &engine, const Setting &setting,
+                   double sampleRate, int numChannels) {
+  engine.setOversampling(setting.oversamplingLog2, setting.filter);
+  engine.setAntialiasing(setting.antialiasing);
+  engine.prepare(sampleRate, kBlockSize, numChannels);
+}
+
+//==============================================================================
+/** 基数 2 の複素 FFT（インプレース） */
+void performFft(std::vector<std::complex<double>> &data) {
+  const size_t size = data.size();
+
+  for (size_t i = 1, j = 0; i < size; ++i) {
+    size_t bit = size >> 1;
+
+    for (; (j & bit) != 0; bit >>= 1)
+      j ^= bit;
+
+    j ^= bit;
+
+    if (i < j)
+      std::swap(data[i], data[j]);
+  }
+
+  for (size_t length = 2; length <= size; length <<= 1) {
+    const double angle = -kTwoPi / (double)length;
+    const std::complex<double> unit(std::cos(angle), std::sin(angle));
+
+    for (size_t start = 0; start < size; start += length) {
+      std::complex<double> twiddle(1.0, 0.0);
+
+      for (size_t k = 0; k < length / 2; ++k) {
+        const auto even = data[start + k];
+        const auto odd = data[start + k + length / 2] * twiddle;
+        data[start + k] = even + odd;
+        data[start + k + length / 2] = even - odd;
+        twiddle *= unit;
+      }
+    }
+  }
+}
+
+double toDb(double powerRatio) {
+  return powerRatio > 0.0 ? 10.0 * std::log10(powerRatio)
+                          : -std::numeric_limits<double>::infinity();
+}
+
+/** 正弦波を通して定常状態の出力を分析する */
+Measurement analyse(const Setting &setting, double sampleRate,
+                    double requestedFrequency, float drive) {
+  // FFT 長にちょうど奇数周期入る周波数に丸める（高調波と折り返しが重ならない）
+  int bin = (int)std::lround(requestedFrequency * kFftSize / sampleRate);
+  bin |= 1;
+  const double frequency = bin * sampleRate / kFftSize;
+
+  VT2BGlueEngine engine;
+  prepareEngine(engine, setting, sampleRate, 1);
+  engine.setDrive(drive);
+  engine.setMix(1.0f);
+
+  const int warmup = (int)(kWarmupSeconds * sampleRate);
+  const int length = warmup + kFftSize;
+  std::vector<float> signal((size_t)length);
+
+  for (int i = 0; i < length; ++i)
+    signal[(size_t)i] =
+        kAmplitude * (float)std::sin(kTwoPi * (double)bin *
+                                     (double)(i % kFftSize) / kFftSize);
+
+  for (int position = 0; position < length; position += kBlockSize) {
+    float *channel = signal.data() + position;
+    engine.setDrive(drive);
+    engine.setMix(1.0f);
+    engine.process(&channel, 1, std::min(kBlockSize, length - position));
+  }
+
+  std::vector<std::complex<double>> spectrum((size_t)kFftSize);
+
+  for (int i = 0; i < kFftSize; ++i)
+    spectrum[(size_t)i] = signal[(size_t)(warmup + i)];
+
+  performFft(spectrum);
+
+  // 片側パワー（直流とナイキストを除き 2 倍）
+  std::vector<double> power((size_t)kFftSize / 2 + 1);
+
+  for (size_t i = 0; i < power.size(); ++i) {
+    const double scale = (i == 0 || i == power.size() - 1) ? 1.0 : 2.0;
+    power[i] = scale * std::norm(spectrum[i]) / ((double)kFftSize * kFftSize);
+  }
+
+  const double fundamental = power[(size_t)bin];
+  double harmonics = 0.0;
+  double total = 0.0;
+
+  for (size_t i = 1; i < power.size(); ++i)
+    total += power[i];
+
+  for (int order = 2; (size_t)(order * bin) < power.size(); ++order)
+    harmonics += power[(size_t)(order * bin)];
+
+  auto getHarmonicDb = [&](int order) {
+    const size_t index = (size_t)(order * bin);
+    return index < power.size() ? toDb(power[index] / fundamental)
+                                : std::numeric_limits<double>::quiet_NaN();
+  };
+
+  Measurement measurement;
+  measurement.frequency = frequency;
+  measurement.drive = drive;
+  measurement.fundamentalDb = toDb(fundamental * 2.0); // 正弦波の振幅 1 を 0 dB に
+  measurement.harmonic2Db = getHarmonicDb(2);
+  measurement.harmonic3Db = getHarmonicDb(3);
+  measurement.thdDb = toDb(harmonics / fundamental);
+  measurement.aliasingDbfs =
+      toDb(std::max(0.0, total - fundamental - harmonics) * 2.0);
+  measurement.thdnDb = toDb(std::max(0.0, total - fundamental) / fundamental);
+  return measurement;
+}
+
+/** ステレオ・512 サンプルブロック・Drive 5 の処理コスト（数回の最小値） */
+double measureCost(const Setting &setting, double sampleRate, double seconds) {
+  constexpr int numChannels = 2;
+
+  VT2BGlueEngine engine;
+  prepareEngine(engine, setting, sampleRate, numChannels);
+
+  const int length = (int)sampleRate;
+  std::vector<std::vector<float>> input(numChannels,
+                                        std::vector<float>((size_t)length));
+
+  for (int channel = 0; channel < numChannels; ++channel)
+    for (int i = 0; i < length; ++i)
+      input[(size_t)channel][(size_t)i] =
+          kAmplitude * (float)std::sin(kTwoPi * 220.0 * (channel + 1) * i /
+                                       sampleRate);
+
+  auto buffer = input;
+  float *pointers[numChannels];
+  int position = 0;
+
+  auto runBlocks = [&](long long numBlocks) {
+    for (long long block = 0; block < numBlocks; ++block) {
+      if (position + kBlockSize > length) {
+        position = 0;
+        buffer = input;
+      }
+
+      for (int channel = 0; channel < numChannels; ++channel)
+        pointers[channel] = buffer[(size_t)channel].data() + position;
+
+      engine.setDrive(5.0f);
+      engine.setMix(1.0f);
+      engine.process(pointers, numChannels, kBlockSize);
+      position += kBlockSize;
+    }
+  };
+
+  runBlocks(std::max<long long>(1, (long long)sampleRate / kBlockSize));
+
+  const long long numBlocks = std::max<long long>(
+      1, (long long)(seconds * sampleRate / kNumRounds) / kBlockSize);
+  double best = 1.0e30;
+
+  for (int round = 0; round < kNumRounds; ++round) {
+    const auto start = std::chrono::steady_clock::now();
+    runBlocks(numBlocks);
+    const auto end = std::chrono::steady_clock::now();
+
+    best = std::min(
+        best, std::chrono::duration<double, std::nano>(end - start).count());
+  }
+
+  return best / ((double)numBlocks * kBlockSize * numChannels);
+}
+
+/** 最悪の折り返しとコストの両方で他の設定に負けない（支配されない）ものに印を付ける */
+void markParetoOptimal(std::vector<SettingResult> &results) {
+  for (auto &result : results) {
+    result.paretoOptimal = true;
+
+    for (const auto &other : results) {
+      const bool noWorse = other.nsPerSample <= result.nsPerSample &&
+                           other.worstAliasingDbfs <= result.worstAliasingDbfs;
+      const bool better = other.nsPerSample < result.nsPerSample ||
+                          other.worstAliasingDbfs < result.worstAliasingDbfs;
+
+      if (&other != &result && noWorse && better) {
+        result.paretoOptimal = false;
+        break;
+      }
+    }
+  }
+}
+
+//==============================================================================
+/** CSV / JSON 用の数値（有限でなければ空 / null） */
+std::string formatNumber(double value, const char *missing) {
+  if (!std::isfinite(value))
+    return missing;
+
+  char text[32];
+  std::snprintf(text, sizeof(text), "%.2f", value);
+  return text;
+}
+
+void writeCsv(std::FILE *file, const std::vector<SettingResult> &results) {
+  std::fprintf(file, "setting,latency_samples,ns_per_sample,pareto,drive,"
+                     "frequency_hz,fundamental_db,h2_db,h3_db,thd_db,"
+                     "aliasing_dbfs,thdn_db\n");
+
+  for (const auto &result : results)
+    for (const auto &measurement : result.measurements)
+      std::fprintf(file, "%s,%d,%.3f,%d,%g,%.1f,%s,%s,%s,%s,%s,%s\n",
+                   result.setting->name, result.latencySamples,
+                   result.nsPerSample, result.paretoOptimal ? 1 : 0,
+                   (double)measurement.drive, measurement.frequency,
+                   formatNumber(measurement.fundamentalDb, "").c_str(),
+                   formatNumber(measurement.harmonic2Db, "").c_str(),
+                   formatNumber(measurement.harmonic3Db, "").c_str(),
+                   formatNumber(measurement.thdDb, "").c_str(),
+                   formatNumber(measurement.aliasingDbfs, "").c_str(),
+                   formatNumber(measurement.thdnDb, "").c_str());
+}
+
+void writeJson(std::FILE *file, const std::vector<SettingResult> &results,
+               double sampleRate) {
+  std::fprintf(file, "{\n");
+  std::fprintf(file, "  \"tool\": \"VT2BAliasingAnalysis\",\n");
+  std::fprintf(file, "  \"simdLevel\": \"%s\",\n",
+               VT2BCpuFeatures::getName(VT2BCpuFeatures::getBestSimdLevel()));
+  std::fprintf(file, "  \"sampleRate\": %g,\n", sampleRate);
+  std::fprintf(file, "  \"amplitude\": %g,\n", (double)kAmplitude);
+  std::fprintf(file, "  \"settings\": [\n");
+
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto &result = results[i];
+
+    std::fprintf(file,
+                 "    {\"name\": \"%s\", \"latencySamples\": %d, "
+                 "\"nsPerSample\": %.3f, \"worstAliasingDbfs\": %s, "
+                 "\"worstThdnDb\": %s, \"pareto\": %s,\n",
+                 result.setting->name, result.latencySamples,
+                 result.nsPerSample,
+                 formatNumber(result.worstAliasingDbfs, "null").c_str(),
+                 formatNumber(result.worstThdnDb, "null").c_str(),
+                 result.paretoOptimal ? "true" : "false");
+    std::fprintf(file, "     \"measurements\": [\n");
+
+    for (size_t j = 0; j < result.measurements.size(); ++j) {
+      const auto &measurement = result.measurements[j];
+
+      std::fprintf(
+          file,
+          "       {\"drive\": %g, \"frequency\": %.1f, \"fundamentalDb\": %s, "
+          "\"h2Db\": %s, \"h3Db\": %s, \"thdDb\": %s, \"aliasingDbfs\": %s, "
+          "\"thdnDb\": %s}%s\n",
+          (double)measurement.drive, measurement.frequency,
+          formatNumber(measurement.fundamentalDb, "null").c_str(),
+          formatNumber(measurement.harmonic2Db, "null").c_str(),
+          formatNumber(measurement.harmonic3Db, "null").c_str(),
+          formatNumber(measurement.thdDb, "null").c_str(),
+          formatNumber(measurement.aliasingDbfs, "null").c_str(),
+          formatNumber(measurement.thdnDb, "null").c_str(),
+          j + 1 < result.measurements.size() ? "," : "");
+    }
+
+    std::fprintf(file, "     ]}%s\n", i + 1 < results.size() ? "," : "");
+  }
+
+  std::fprintf(file, "  ]\n}\n");
+}
+
+bool writeFile(const std::string &path,
+               const std::vector<SettingResult> &results, double sampleRate,
+               bool json) {
+  std::FILE *file = std::fopen(path.c_str(), "w");
+
+  if (file == nullptr)
+    return false;
+
+  if (json)
+    writeJson(file, results, sampleRate);
+  else
+    writeCsv(file, results);
+
+  std::fclose(file);
+  return true;
+}
+
+bool parseOptions(int argc, char *argv[], Options &options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string argument = argv[i];
+
+    if (i + 1 >= argc)
+      return false;
+
+    const char *value = argv[++i];
+
+    if (argument == "--sample-rate")
+      options.sampleRate = std::atof(value);
+    else if (argument == "--seconds")
+      options.seconds = std::atof(value);
+    else if (argument == "--csv")
+      options.csvPath = value;
+    else if (argument == "--json")
+      options.jsonPath = value;
+    else if (argument == "--filter")
+      options.filter = value;
+    else
+      return false;
+  }
+
+  return options.sampleRate >= 8000.0 && options.seconds > 0.0;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  Options options;
+
+  if (!parseOptions(argc, argv, options)) {
+    std::fprintf(stderr, "usage: VT2BAliasingAnalysis [--sample-rate hz] "
+                         "[--csv file] [--json file] [--seconds s] "
+                         "[--filter text]\n");
+    return 2;
+  }
+
+  enableFlushToZero();
+
+  std::vector<SettingResult> results;
+
+  for (const auto &setting : kSettings) {
+    if (!options.filter.empty() &&
+        std::string(setting.name).find(options.filter) == std::string::npos)
+      continue;
+
+    SettingResult result{};
+    result.setting = &setting;
+    result.worstAliasingDbfs = -std::numeric_limits<double>::infinity();
+    result.worstThdnDb = -std::numeric_limits<double>::infinity();
+
+    VT2BGlueEngine engine;
+    prepareEngine(engine, setting, options.sampleRate, 1);
+    result.latencySamples = engine.getLatencyInSamples();
+
+    for (const float drive : kDrives) {
+      for (const double frequency : kFrequencies) {
+        if (frequency >= options.sampleRate * 0.45)
+          continue;
+
+        const auto measurement =
+            analyse(setting, options.sampleRate, frequency, drive);
+        result.measurements.push_back(measurement);
+        result.worstAliasingDbfs =
+            std::max(result.worstAliasingDbfs, measurement.aliasingDbfs);
+        result.worstThdnDb = std::max(result.worstThdnDb, measurement.thdnDb);
+      }
+    }
+
+    result.nsPerSample =
+        measureCost(setting, options.sampleRate, options.seconds);
+    results.push_back(result);
+
+    std::fprintf(stderr, "%-14s %8.3f ns/sample  worst aliasing %7.1f dBFS\n",
+                 setting.name, result.nsPerSample, result.worstAliasingDbfs);
+  }
+
+  markParetoOptimal(results);
+
+  // 標準出力にはコスト順の要約
+  auto summary = results;
+  std::sort(summary.begin(), summary.end(),
+            [](const SettingResult &a, const SettingResult &b) {
+              return a.nsPerSample < b.nsPerSample;
+            });
+
+  std::printf("%-14s %8s %12s %18s %14s %7s\n", "setting", "latency",
+              "ns/sample", "worst aliasing", "worst THD+N", "pareto");
+
+  for (const auto &result : summary)
+    std::printf("%-14s %8d %12.3f %13.1f dBFS %11.1f dB %7s\n",
+                result.setting->name, result.latencySamples,
+                result.nsPerSample, result.worstAliasingDbfs,
+                result.worstThdnDb, result.paretoOptimal ? "*" : "");
+
+  if (!options.csvPath.empty() &&
+      !writeFile(options.csvPath, results, options.sampleRate, false)) {
+    std::fprintf(stderr, "cannot write: %s\n", options.csvPath.c_str());
+    return 2;
+  }
+
+  if (!options.jsonPath.empty() &&
+      !writeFile(options.jsonPath, results, options.sampleRate, true)) {
+    std::fprintf(stderr, "cannot write: %s\n", options.jsonPath.c_str());
+    return 2;
+  }
+
+  return 0;
+}
@@ -0,0 +1,403 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Benchmark Suite
+
+    DSPチェーン（VT2BGlueEngine）をヘッドレスで回し、設定の組み合わせごとに
+    1 サンプル（1 チャンネル）あたりの処理時間と処理サンプル数/秒を JSON で出す。
+
+      サンプルレート  44.1 / 48 / 96 / 192 kHz
+      ブロック長      32 / 512 / 2048
+      Drive / Mix     0 / 100%、5 / 100%、10 / 100%、5 / 50%
+      パラメータ      静的 / オートメーション（ブロックごとに Drive と Mix を動かす）
+      チャンネル      モノ / ステレオ
+
+    ベースライン（以前にこのツールが出した JSON）を渡すと、同じ名前の結果と比べ、
+    しきい値（%）を超えて遅くなった構成があれば終了コード 1 で終わる。
+
+    使い方: VT2BBenchmarkSuite [--seconds 秒数（構成ごと、既定 0.1）]
+                               [--output 出力 JSON（既定は標準出力）]
+                               [--baseline ベースライン JSON]
+                               [--threshold 許容する悪化 %（既定 10）]
+                               [--filter 名前に含む文字列]
+  ==============================================================================
+*/
+
+#include "dsp/VT2BGlueEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+namespace {
+constexpr int kNumRounds = 8;
+
+const double kSampleRates[] = {44100.0, 48000.0, 96000.0, 192000.0};
+const int kBlockSizes[] = {32, 512, 2048};
+const int kChannelCounts[] = {1, 2};
+
+struct Setting {
+  float drive;
+  float mix; // 0-1
+};
+
+const Setting kSettings[] = {
+    {0.0f, 1.0f},
+    {5.0f, 1.0f},
+    {10.0f, 1.0f},
+    {5.0f, 0.5f},
+};
+
+// オートメーション: Drive を ±1、Mix を最大 10% 下げる方向に 1 Hz で動かす
+constexpr float kAutomationDriveDepth = 1.0f;
+constexpr float kAutomationMixDepth = 0.1f;
+constexpr double kAutomationRate = 1.0;
+
+struct Configuration {
+  double sampleRate;
+  int blockSize;
+  Setting setting;
+  bool automated;
+  int numChannels;
+
+  std::string getName() const {
+    char name[128];
+    std::snprintf(name, sizeof(name), "sr%d/b%d/d%g/m%d/%s/%s",
+                  (int)sampleRate, blockSize, (double)setting.drive,
+                  (int)std::lround(setting.mix * 100.0f),
+                  automated ? "automated" : "static",
+                  numChannels == 1 ? "mono" : "stereo");
+    return name;
+  }
+};
+
+struct Result {
+  Configuration configuration;
+  std::string name;
+  double nsPerSample;       // 1 サンプル・1 チャンネルあたり
+  double samplesPerSecond;  // チャンネル込みのサンプル数/秒
+  double realtimeFactor;    // 実時間の何倍で処理できるか
+};
+
+struct Options {
+  double seconds = 0.1;
+  std::string outputPath;
+  std::string baselinePath;
+  double threshold = 10.0;
+  std::string filter;
+};
+
+void enableFlushToZero() {
+#if defined(__SSE__) || defined(_M_X64)
+  _mm_setcsr(_mm_getcsr() | 0x8040); // FTZ | DAZ
+#endif
+}
+
+/** 1 秒分の入力（正弦波 + 雑音、チャンネルごとに周波数を変える） */
+std::vector<std::vector<float>> makeInput(double sampleRate,
+                                          int numChannels) {
+  const int length = (int)sampleRate;
+  std::vector<std::vector<float>> input((size_t)numChannels,
+                                        std::vector<float>((size_t)length));
+  std::mt19937 random(1);
+  std::uniform_real_distribution<float> noise(-0.05f, 0.05f);
+
+  for (int channel = 0; channel < numChannels; ++channel)
+    for (int i = 0; i < length; ++i)
+      input[(size_t)channel][(size_t)i] =
+          0.7f * (float)std::sin(6.283185307179586 * 220.0 * (channel + 1) *
+                                 i / sampleRate) +
+          noise(random);
+
+  return input;
+}
+
+Result measure(const Configuration &configuration, double seconds) {
+  const int numChannels = configuration.numChannels;
+  const int blockSize = configuration.blockSize;
+  const double sampleRate = configuration.sampleRate;
+
+  VT2BGlueEngine engine;
+  engine.prepare(sampleRate, blockSize, numChannels);
+  engine.setDrive(configuration.setting.drive);
+  engine.setMix(configuration.setting.mix);
+
+  const auto input = makeInput(sampleRate, numChannels);
+  const int length = (int)input[0].size();
+  auto buffer = input;
+  std::vector<float *> pointers((size_t)numChannels);
+  long long blockCounter = 0;
+
+  auto runBlocks = [&](long long numBlocks) {
+    int position = 0;
+
+    for (long long block = 0; block < numBlocks; ++block, ++blockCounter) {
+      if (position + blockSize > length) {
+        position = 0;
+        buffer = input;
+      }
+
+      for (int channel = 0; channel < numChannels; ++channel)
+        pointers[(size_t)channel] = buffer[(size_t)channel].data() + position;
+
+      // プロセッサと同じくブロックごとにパラメータを渡す
+      float drive = configuration.setting.drive;
+      float mix = configuration.setting.mix;
+
+      if (configuration.automated) {
+        const double time = (double)(blockCounter * blockSize) / sampleRate;
+        const float phase = (float)std::sin(6.283185307179586 *
+                                            kAutomationRate * time);
+        drive = std::clamp(drive + kAutomationDriveDepth * phase, 0.0f,
+                           10.0f);
+        mix = mix * (1.0f - kAutomationMixDepth * (0.5f + 0.5f * phase));
+      }
+
+      engine.setDrive(drive);
+      engine.setMix(mix);
+      engine.process(pointers.data(), numChannels, blockSize);
+      position += blockSize;
+    }
+  };
+
+  // ウォームアップ（スムージング完了・表の構築を含む）
+  runBlocks(std::max<long long>(1, (long long)sampleRate / blockSize));
+
+  // 割り込み等の影響を除くため、数回に分けて測った最小値を採る
+  const long long numBlocks = std::max<long long>(
+      1, (long long)(seconds * sampleRate / kNumRounds) / blockSize);
+  double best = 1.0e30;
+
+  for (int round = 0; round < kNumRounds; ++round) {
+    const auto start = std::chrono::steady_clock::now();
+    runBlocks(numBlocks);
+    const auto end = std::chrono::steady_clock::now();
+
+    best = std::min(
+        best, std::chrono::duration<double, std::nano>(end - start).count());
+  }
+
+  Result result;
+  result.configuration = configuration;
+  result.name = configuration.getName();
+  result.nsPerSample = best / ((double)numBlocks * blockSize * numChannels);
+  result.samplesPerSecond = 1.0e9 / result.nsPerSample;
+  result.realtimeFactor =
+      result.samplesPerSecond / (sampleRate * numChannels);
+  return result;
+}
+
+//==============================================================================
+void writeJson(std::FILE *file, const std::vector<Result> &results,
+               const Options &options) {
+  std::fprintf(file, "{\n");
+  std::fprintf(file, "  \"benchmark\": \"VT2BBenchmarkSuite\",\n");
+  std::fprintf(file, "  \"simdLevel\": \"%s\",\n",
+               VT2BCpuFeatures::getName(VT2BCpuFeatures::getBestSimdLevel()));
+  std::fprintf(file, "  \"secondsPerConfiguration\": %g,\n", options.seconds);
+  std::fprintf(file, "  \"results\": [\n");
+
+  // 1 行に 1 構成（ベースラインの読み込みはこの形を前提にしている）
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto &result = results[i];
+    const auto &configuration = result.configuration;
+
+    std::fprintf(file,
+                 "    {\"name\": \"%s\", \"sampleRate\": %d, "
+                 "\"blockSize\": %d, \"drive\": %g, \"mix\": %g, "
+                 "\"automated\": %s, \"channels\": %d, "
+                 "\"nsPerSample\": %.4f, \"samplesPerSecond\": %.0f, "
+                 "\"realtimeFactor\": %.1f}%s\n",
+                 result.name.c_str(), (int)configuration.sampleRate,
+                 configuration.blockSize, (double)configuration.setting.drive,
+                 (double)configuration.setting.mix,
+                 configuration.automated ? "true" : "false",
+                 configuration.numChannels, result.nsPerSample,
+                 result.samplesPerSecond, result.realtimeFactor,
+                 i + 1 < results.size() ? "," : "");
+  }
+
+  std::fprintf(file, "  ]\n}\n");
+}
+
+/** "key": の直後の値の先頭（見つからなければ nullptr） */
+const char *findValue(const char *line, const char *key) {
+  const std::string quoted = std::string("\"") + key + "\":";
+  const char *found = std::strstr(line, quoted.c_str());
+
+  if (found == nullptr)
+    return nullptr;
+
+  found += quoted.size();
+
+  while (*found == ' ')
+    ++found;
+
+  return found;
+}
+
+/**
+ * このツールが出した JSON から name → nsPerSample を読む
+ * 読めなければ false。
+ */
+bool readBaseline(const std::string &path,
+                  std::map<std::string, double> &baseline) {
+  std::FILE *file = std::fopen(path.c_str(), "r");
+
+  if (file == nullptr)
+    return false;
+
+  char line[1024];
+
+  while (std::fgets(line, sizeof(line), file) != nullptr) {
+    const char *name = findValue(line, "name");
+    const char *nsPerSample = findValue(line, "nsPerSample");
+
+    if (name == nullptr || nsPerSample == nullptr || *name != '"')
+      continue;
+
+    const char *nameEnd = std::strchr(name + 1, '"');
+
+    if (nameEnd == nullptr)
+      continue;
+
+    baseline[std::string(name + 1, nameEnd)] = std::atof(nsPerSample);
+  }
+
+  std::fclose(file);
+  return !baseline.empty();
+}
+
+/** ベースラインと比べ、しきい値を超えて悪化した構成の数を返す */
+int compareWithBaseline(const std::vector<Result> &results,
+                        const std::map<std::string, double> &baseline,
+                        double threshold) {
+  int regressions = 0;
+  int compared = 0;
+
+  for (const auto &result : results) {
+    const auto found = baseline.find(result.name);
+
+    if (found == baseline.end() || found->second <= 0.0)
+      continue;
+
+    ++compared;
+    const double change = (result.nsPerSample / found->second - 1.0) * 100.0;
+
+    if (change > threshold) {
+      ++regressions;
+      std::fprintf(stderr, "REGRESSION %-40s %8.3f -> %8.3f ns/sample (%+.1f%%)\n",
+                   result.name.c_str(), found->second, result.nsPerSample,
+                   change);
+    }
+  }
+
+  std::fprintf(stderr,
+               "%d of %d configurations regressed by more than %.1f%%\n",
+               regressions, compared, threshold);
+  return regressions;
+}
+
+bool parseOptions(int argc, char *argv[], Options &options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string argument = argv[i];
+
+    if (i + 1 >= argc)
+      return false;
+
+    const char *value = argv[++i];
+
+    if (argument == "--seconds")
+      options.seconds = std::atof(value);
+    else if (argument == "--output")
+      options.outputPath = value;
+    else if (argument == "--baseline")
+      options.baselinePath = value;
+    else if (argument == "--threshold")
+      options.threshold = std::atof(value);
+    else if (argument == "--filter")
+      options.filter = value;
+    else
+      return false;
+  }
+
+  return options.seconds > 0.0;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  Options options;
+
+  if (!parseOptions(argc, argv, options)) {
+    std::fprintf(stderr,
+                 "usage: VT2BBenchmarkSuite [--seconds s] [--output file] "
+                 "[--baseline file] [--threshold percent] [--filter text]\n");
+    return 2;
+  }
+
+  // 計測前にベースラインを読む（読めなければ計測しない）
+  std::map<std::string, double> baseline;
+
+  if (!options.baselinePath.empty() &&
+      !readBaseline(options.baselinePath, baseline)) {
+    std::fprintf(stderr, "cannot read baseline: %s\n",
+                 options.baselinePath.c_str());
+    return 2;
+  }
+
+  enableFlushToZero();
+
+  std::vector<Result> results;
+
+  for (const double sampleRate : kSampleRates)
+    for (const int blockSize : kBlockSizes)
+      for (const auto &setting : kSettings)
+        for (const bool automated : {false, true})
+          for (const int numChannels : kChannelCounts) {
+            const Configuration configuration{sampleRate, blockSize, setting,
+                                              automated, numChannels};
+
+            if (!options.filter.empty() &&
+                configuration.getName().find(options.filter) ==
+                    std::string::npos)
+              continue;
+
+            results.push_back(measure(configuration, options.seconds));
+            std::fprintf(stderr, "%-40s %8.3f ns/sample\n",
+                         results.back().name.c_str(),
+                         results.back().nsPerSample);
+          }
+
+  std::FILE *output = stdout;
+
+  if (!options.outputPath.empty()) {
+    output = std::fopen(options.outputPath.c_str(), "w");
+
+    if (output == nullptr) {
+      std::fprintf(stderr, "cannot write: %s\n", options.outputPath.c_str());
+      return 2;
+    }
+  }
+
+  writeJson(output, results, options);
+
+  if (output != stdout)
+    std::fclose(output);
+
+  if (!baseline.empty() &&
+      compareWithBaseline(results, baseline, options.threshold) > 0)
+    return 1;
+
+  return 0;
+}
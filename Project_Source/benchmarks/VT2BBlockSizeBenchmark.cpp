@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Block Size Benchmark
+
+    ホストのブロック長 1 〜 8192 サンプルでの処理コストを、1 回の呼び出し
+    あたりと 1 サンプルあたりの両方で測る。呼び出しごとにプロセッサと同じ
+    パラメータ設定（Drive / Mix / リンク / バイパス）も行う。
+    小さいブロックでは呼び出しあたりの固定コストが支配的になる。
+
+    使い方: VT2BBlockSizeBenchmark [秒数（既定 2.0）]
+  ==============================================================================
+*/
+
+#include "dsp/VT2BGlueEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+namespace {
+constexpr double kSampleRate = 48000.0;
+constexpr int kNumChannels = 2;
+constexpr int kNumRounds = 8;
+
+// prepare に渡す最大ブロック長（小さいブロックはこの準備のまま呼ばれる想定）
+constexpr int kPreparedBlockSize = 512;
+
+struct Configuration {
+  const char *name;
+  int oversamplingFactorLog2;
+  VT2BAntialiasing antialiasing;
+  bool quantumAligned;
+};
+
+const Configuration kConfigurations[] = {
+    {"1x", 0, VT2BAntialiasing::Off, false},
+    {"1x+quantum", 0, VT2BAntialiasing::Off, true},
+    {"2x", 1, VT2BAntialiasing::Off, false},
+    {"1x+ADAA2", 0, VT2BAntialiasing::ADAA2, false},
+};
+
+void enableFlushToZero() {
+#if defined(__SSE__) || defined(_M_X64)
+  _mm_setcsr(_mm_getcsr() | 0x8040); // FTZ | DAZ
+#endif
+}
+
+/** 1 回の呼び出し（全チャンネル）あたりの処理時間 [ns] */
+double measure(const Configuration &configuration, int blockSize,
+               double seconds) {
+  VT2BGlueEngine engine;
+  engine.setOversampling(configuration.oversamplingFactorLog2,
+                         VT2BOversamplingFilter::MinimumPhase);
+  engine.setAntialiasing(configuration.antialiasing);
+  engine.setQuantumAligned(configuration.quantumAligned);
+  engine.prepare(kSampleRate, std::max(blockSize, kPreparedBlockSize),
+                 kNumChannels);
+  engine.setDrive(5.0f);
+  engine.setMix(1.0f);
+
+  // 入力は 1 秒分を繰り返し使う（キャッシュに収まりすぎないように）
+  const int length = (int)kSampleRate;
+  std::vector<std::vector<float>> input(kNumChannels,
+                                        std::vector<float>((size_t)length));
+  std::mt19937 random(1);
+  std::uniform_real_distribution<float> noise(-0.05f, 0.05f);
+
+  for (auto &channel : input)
+    for (int i = 0; i < length; ++i)
+      channel[(size_t)i] =
+          0.7f * std::sin(6.2831853f * 220.0f * (float)i / (float)kSampleRate) +
+          noise(random);
+
+  std::vector<std::vector<float>> buffer = input;
+  std::vector<float *> pointers(kNumChannels);
+
+  auto runBlocks = [&](long long numBlocks) {
+    int position = 0;
+
+    for (long long block = 0; block < numBlocks; ++block) {
+      if (position + blockSize > length)
+        position = 0;
+
+      for (int channel = 0; channel < kNumChannels; ++channel)
+        pointers[(size_t)channel] = buffer[(size_t)channel].data() + position;
+
+      // プロセッサの processBlock と同じくパラメータを毎回設定する
+      engine.setDrive(5.0f);
+      engine.setMix(1.0f);
+      engine.setEnvelopeLink(VT2BEnvelopeLink::Independent);
+      engine.setBypassed(false);
+      engine.process(pointers.data(), kNumChannels, blockSize);
+      position += blockSize;
+    }
+  };
+
+  // ウォームアップ（スムージング完了・表の構築を含む）
+  runBlocks(std::max<long long>(1, (long long)kSampleRate / blockSize));
+  buffer = input;
+
+  // 割り込み等の影響を除くため、数回に分けて測った最小値を採る
+  const long long numBlocks = std::max<long long>(
+      1, (long long)(seconds * kSampleRate / kNumRounds) / blockSize);
+  double best = 1.0e30;
+
+  for (int round = 0; round < kNumRounds; ++round) {
+    const auto start = std::chrono::steady_clock::now();
+    runBlocks(numBlocks);
+    const auto end = std::chrono::steady_clock::now();
+
+    best = std::min(
+        best, std::chrono::duration<double, std::nano>(end - start).count());
+  }
+
+  return best / (double)numBlocks;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const double seconds = argc > 1 ? std::atof(argv[1]) : 2.0;
+
+  enableFlushToZero();
+
+  std::printf("VT-2B block size benchmark (%s, %d ch, %.0f Hz, drive 5)\n",
+              VT2BCpuFeatures::getName(VT2BCpuFeatures::getBestSimdLevel()),
+              kNumChannels, kSampleRate);
+  std::printf("ns per call / ns per sample per channel, sub-block %d\n\n",
+              VT2BGlueEngine::kSubBlockSize);
+
+  std::printf("%8s", "block");
+  for (const auto &configuration : kConfigurations)
+    std::printf(" %10s %8s", configuration.name, "/sample");
+  std::printf("\n");
+
+  for (int blockSize : {1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048,
+                        4096, 8192}) {
+    std::printf("%8d", blockSize);
+
+    for (const auto &configuration : kConfigurations) {
+      const double perCall = measure(configuration, blockSize, seconds);
+      std::printf(" %10.1f %8.2f", perCall,
+                  perCall / (blockSize * kNumChannels));
+    }
+
+    std::printf("\n");
+  }
+
+  return 0;
+}
@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Channel Scaling Benchmark
+
+    チャンネル数 1 〜 16（モノ〜9.1.6）での 1 サンプルあたりの処理コストを測る。
+    エンベロープの再帰はチャンネルを SIMD レーンに載せるので、
+    チャンネルあたりのコストはチャンネル数が増えるほど下がる。
+
+    使い方: VT2BChannelScalingBenchmark [秒数（既定 2.0）]
+  ==============================================================================
+*/
+
+#include "dsp/VT2BGlueEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+namespace {
+constexpr double kSampleRate = 48000.0;
+constexpr int kBlockSize = 512;
+constexpr int kNumRounds = 8;
+
+struct Layout {
+  const char *name;
+  int numChannels;
+};
+
+const Layout kLayouts[] = {
+    {"mono", 1},   {"stereo", 2}, {"quad", 4},   {"5.1", 6},
+    {"7.1", 8},    {"7.1.4", 12}, {"9.1.6", 16},
+};
+
+struct Configuration {
+  const char *name;
+  int oversamplingFactorLog2;
+  VT2BAntialiasing antialiasing;
+  VT2BEnvelopeLink envelopeLink;
+};
+
+const Configuration kConfigurations[] = {
+    {"1x", 0, VT2BAntialiasing::Off, VT2BEnvelopeLink::Independent},
+    {"1x linked", 0, VT2BAntialiasing::Off, VT2BEnvelopeLink::Max},
+    {"2x", 1, VT2BAntialiasing::Off, VT2BEnvelopeLink::Independent},
+};
+
+void enableFlushToZero() {
+#if defined(__SSE__) || defined(_M_X64)
+  _mm_setcsr(_mm_getcsr() | 0x8040); // FTZ | DAZ
+#endif
+}
+
+/** 1 サンプル（1 チャンネル）あたりの処理時間 [ns] */
+double measure(const Configuration &configuration, int numChannels,
+               double seconds) {
+  const int blockSize = kBlockSize;
+
+  VT2BGlueEngine engine;
+  engine.setOversampling(configuration.oversamplingFactorLog2,
+                         VT2BOversamplingFilter::MinimumPhase);
+  engine.setAntialiasing(configuration.antialiasing);
+  engine.setEnvelopeLink(configuration.envelopeLink);
+  engine.prepare(kSampleRate, blockSize, numChannels);
+  engine.setDrive(5.0f);
+  engine.setMix(1.0f);
+
+  // 入力は 0.25 秒分を繰り返し使う（16 チャンネルでも L2 程度に収める）
+  const int length = (int)kSampleRate / 4;
+  std::vector<std::vector<float>> input(numChannels,
+                                        std::vector<float>((size_t)length));
+  std::mt19937 random(1);
+  std::uniform_real_distribution<float> noise(-0.05f, 0.05f);
+
+  for (auto &channel : input)
+    for (int i = 0; i < length; ++i)
+      channel[(size_t)i] =
+          0.7f * std::sin(6.2831853f * 220.0f * (float)i / (float)kSampleRate) +
+          noise(random);
+
+  std::vector<std::vector<float>> buffer = input;
+  std::vector<float *> pointers(numChannels);
+
+  auto runBlocks = [&](long long numBlocks) {
+    int position = 0;
+
+    for (long long block = 0; block < numBlocks; ++block) {
+      if (position + blockSize > length)
+        position = 0;
+
+      for (int channel = 0; channel < numChannels; ++channel)
+        pointers[(size_t)channel] = buffer[(size_t)channel].data() + position;
+
+      engine.process(pointers.data(), numChannels, blockSize);
+      position += blockSize;
+    }
+  };
+
+  // ウォームアップ（スムージング完了・表の構築を含む）
+  runBlocks(std::max<long long>(1, (long long)kSampleRate / blockSize));
+  buffer = input;
+
+  // 割り込み等の影響を除くため、数回に分けて測った最小値を採る
+  const long long numBlocks = std::max<long long>(
+      1, (long long)(seconds * kSampleRate / kNumRounds) / blockSize);
+  double best = 1.0e30;
+
+  for (int round = 0; round < kNumRounds; ++round) {
+    const auto start = std::chrono::steady_clock::now();
+    runBlocks(numBlocks);
+    const auto end = std::chrono::steady_clock::now();
+
+    best = std::min(
+        best, std::chrono::duration<double, std::nano>(end - start).count());
+  }
+
+  return best / ((double)numBlocks * blockSize * numChannels);
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const double seconds = argc > 1 ? std::atof(argv[1]) : 2.0;
+
+  enableFlushToZero();
+
+  std::printf("VT-2B channel scaling benchmark (%s, block %d, %.0f Hz, "
+              "drive 5)\n",
+              VT2BCpuFeatures::getName(VT2BCpuFeatures::getBestSimdLevel()),
+              kBlockSize, kSampleRate);
+  std::printf("ns/sample per channel (per frame in parentheses)\n\n");
+
+  std::printf("%8s %4s", "layout", "ch");
+  for (const auto &configuration : kConfigurations)
+    std::printf(" %18s", configuration.name);
+  std::printf("\n");
+
+  for (const auto &layout : kLayouts) {
+    std::printf("%8s %4d", layout.name, layout.numChannels);
+
+    for (const auto &configuration : kConfigurations) {
+      const double perChannel =
+          measure(configuration, layout.numChannels, seconds);
+      std::printf(" %8.2f (%7.2f)", perChannel,
+                  perChannel * layout.numChannels);
+    }
+
+    std::printf("\n");
+  }
+
+  return 0;
+}
@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Double Precision Benchmark
+
+    倍精度ホスト向けの 2 通りの処理を比べる:
+      convert  double → float に変換して float 版を処理し、double に戻す
+               （supportsDoublePrecisionProcessing() が false のときに
+               ホスト / ラッパーが行う変換に相当）
+      dry64    VT2BGlueEngine::process(double) に渡す（Dry 経路のみ double、
+               Wet 系は内部で float に変換して処理する）
+
+    使い方: VT2BDoublePrecisionBenchmark [秒数（既定 2.0）]
+  ==============================================================================
+*/
+
+#include "dsp/VT2BGlueEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+namespace {
+constexpr double kSampleRate = 48000.0;
+constexpr int kNumChannels = 2;
+constexpr int kBlockSize = 512;
+constexpr int kNumRounds = 8;
+
+struct Configuration {
+  const char *name;
+  int oversamplingFactorLog2;
+  float mix;
+};
+
+const Configuration kConfigurations[] = {
+    {"1x mix 100%", 0, 1.0f},
+    {"1x mix 50%", 0, 0.5f},
+    {"1x mix 0%", 0, 0.0f},
+    {"2x mix 100%", 1, 1.0f},
+};
+
+void enableFlushToZero() {
+#if defined(__SSE__) || defined(_M_X64)
+  _mm_setcsr(_mm_getcsr() | 0x8040); // FTZ | DAZ
+#endif
+}
+
+/** 1 サンプル（1 チャンネル）あたりの処理時間 [ns] */
+double measure(const Configuration &configuration, bool dryInDouble,
+               double seconds) {
+  VT2BGlueEngine engine;
+  engine.setOversampling(configuration.oversamplingFactorLog2,
+                         VT2BOversamplingFilter::MinimumPhase);
+  engine.prepare(kSampleRate, kBlockSize, kNumChannels);
+  engine.setDrive(5.0f);
+  engine.setMix(configuration.mix);
+
+  const int length = (int)kSampleRate;
+  std::vector<std::vector<double>> input(kNumChannels,
+                                         std::vector<double>((size_t)length));
+  std::mt19937 random(1);
+  std::uniform_real_distribution<double> noise(-0.05, 0.05);
+
+  for (auto &channel : input)
+    for (int i = 0; i < length; ++i)
+      channel[(size_t)i] =
+          0.7 * std::sin(6.283185307179586 * 220.0 * i / kSampleRate) +
+          noise(random);
+
+  std::vector<std::vector<double>> buffer = input;
+  std::vector<std::vector<float>> converted(
+      kNumChannels, std::vector<float>((size_t)kBlockSize));
+  std::vector<double *> pointers(kNumChannels);
+  std::vector<float *> convertedPointers(kNumChannels);
+
+  for (int channel = 0; channel < kNumChannels; ++channel)
+    convertedPointers[(size_t)channel] = converted[(size_t)channel].data();
+
+  auto runBlocks = [&](long long numBlocks) {
+    int position = 0;
+
+    for (long long block = 0; block < numBlocks; ++block) {
+      if (position + kBlockSize > length)
+        position = 0;
+
+      for (int channel = 0; channel < kNumChannels; ++channel)
+        pointers[(size_t)channel] = buffer[(size_t)channel].data() + position;
+
+      if (dryInDouble) {
+        engine.process(pointers.data(), kNumChannels, kBlockSize);
+      } else {
+        for (int channel = 0; channel < kNumChannels; ++channel)
+          std::copy(pointers[(size_t)channel],
+                    pointers[(size_t)channel] + kBlockSize,
+                    convertedPointers[(size_t)channel]);
+
+        engine.process(convertedPointers.data(), kNumChannels, kBlockSize);
+
+        for (int channel = 0; channel < kNumChannels; ++channel)
+          std::copy(convertedPointers[(size_t)channel],
+                    convertedPointers[(size_t)channel] + kBlockSize,
+                    pointers[(size_t)channel]);
+      }
+
+      position += kBlockSize;
+    }
+  };
+
+  runBlocks(std::max<long long>(1, (long long)kSampleRate / kBlockSize));
+  buffer = input;
+
+  const long long numBlocks = std::max<long long>(
+      1, (long long)(seconds * kSampleRate / kNumRounds) / kBlockSize);
+  double best = 1.0e30;
+
+  for (int round = 0; round < kNumRounds; ++round) {
+    const auto start = std::chrono::steady_clock::now();
+    runBlocks(numBlocks);
+    const auto end = std::chrono::steady_clock::now();
+
+    best = std::min(
+        best, std::chrono::duration<double, std::nano>(end - start).count());
+  }
+
+  return best / ((double)numBlocks * kBlockSize * kNumChannels);
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const double seconds = argc > 1 ? std::atof(argv[1]) : 2.0;
+
+  enableFlushToZero();
+
+  std::printf("VT-2B double precision benchmark (%s, %d ch, %.0f Hz, "
+              "block %d, drive 5)\n",
+              VT2BCpuFeatures::getName(VT2BCpuFeatures::getBestSimdLevel()),
+              kNumChannels, kSampleRate, kBlockSize);
+  std::printf("ns/sample per channel\n\n");
+
+  std::printf("%14s %10s %10s\n", "", "convert", "dry64");
+
+  for (const auto &configuration : kConfigurations)
+    std::printf("%14s %10.2f %10.2f\n", configuration.name,
+                measure(configuration, false, seconds),
+                measure(configuration, true, seconds));
+
+  return 0;
+}
@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Golden Reference
+
+    DSPエンジン導入前の PluginProcessor.cpp のサンプル単位処理（スカラー、std::pow、
+    サンプルごとの係数計算）をそのまま凍結したもの。最適化したカーネルの精度検証
+    （VT2BAccuracyTest）の基準に使う。
+
+    音を意図して変えるとき以外は手を入れないこと。定数も VT2BConstants.h を
+    参照せず、ここに写しを持つ。
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "dsp/VT2BSmoothedValue.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace VT2BGoldenConstants {
+constexpr float kSaturationCoeffMin = 0.0f;
+constexpr float kSaturationCoeffMax = 3.0f;
+constexpr float kSaturationCurve = 2.5f;
+
+constexpr float kHarmonic2ndAmount = 0.40f;
+constexpr float kHarmonic3rdAmount = 0.25f;
+
+constexpr float kTransientThreshold = 0.2f;
+constexpr float kTransientKnee = 0.15f;
+constexpr float kTransientAmountMin = 0.08f;
+constexpr float kTransientAmountMax = 0.50f;
+constexpr float kEnvelopeAttack = 0.001f;
+constexpr float kEnvelopeRelease = 0.050f;
+
+constexpr float kDriveMax = 10.0f;
+} // namespace VT2BGoldenConstants
+
+//==============================================================================
+/**
+ * 従来処理の凍結版
+ *
+ * チャンネルごとに独立したエンベロープを持ち、Drive / Mix は全チャンネル共通の
+ * スムーザー（20 ms の線形ランプ）から 1 サンプルずつ読む。呼び出し側で
+ * FTZ/DAZ を設定しておくこと（従来処理は ScopedNoDenormals の下で動いていた）。
+ */
+class VT2BGoldenReference {
+public:
+  void prepare(double sampleRate, int numChannels) {
+    currentSampleRate = sampleRate;
+
+    smoothedDrive.reset(sampleRate, 0.02); // 20ms
+    smoothedMix.reset(sampleRate, 0.02);
+
+    envelopes.assign((size_t)numChannels, 0.0f);
+  }
+
+  void setDrive(float newDrive) { smoothedDrive.setTargetValue(newDrive); }
+
+  /** Mix は 0〜1 */
+  void setMix(float newMix) { smoothedMix.setTargetValue(newMix); }
+
+  /** インプレース処理（チャンネル数は prepare() で指定した数） */
+  void process(float *const *channels, int numSamples) {
+    const int numChannels = (int)envelopes.size();
+
+    for (int sample = 0; sample < numSamples; ++sample) {
+      const float currentDrive = smoothedDrive.getNextValue();
+      const float currentMix = smoothedMix.getNextValue();
+
+      const float preDriveGain =
+          1.0f + (currentDrive / VT2BGoldenConstants::kDriveMax) * 1.5f;
+
+      for (int channel = 0; channel < numChannels; ++channel) {
+        const float dry = channels[channel][sample];
+
+        float wet = dry * preDriveGain;
+        wet = processSaturation(wet, currentDrive);
+        wet += processHarmonics(dry * preDriveGain, currentDrive);
+        wet = processTransient(wet, envelopes[(size_t)channel], currentDrive);
+        wet *= calculateMakeupGain(currentDrive);
+
+        channels[channel][sample] =
+            dry * (1.0f - currentMix) + wet * currentMix;
+      }
+    }
+  }
+
+private:
+  float processSaturation(float input, float drive) const {
+    using namespace VT2BGoldenConstants;
+
+    float normalizedDrive = drive / kDriveMax;
+    float k = kSaturationCoeffMin +
+              normalizedDrive * (kSaturationCoeffMax - kSaturationCoeffMin);
+
+    float absInput = std::abs(input);
+    float saturation = std::pow(absInput, kSaturationCurve);
+
+    return input / (1.0f + k * saturation);
+  }
+
+  float processHarmonics(float input, float drive) const {
+    using namespace VT2BGoldenConstants;
+
+    float normalizedDrive = drive / kDriveMax;
+
+    float harmonic2 = input * input * kHarmonic2ndAmount * normalizedDrive;
+    float harmonic3 = input * input * input * kHarmonic3rdAmount *
+                      normalizedDrive;
+
+    harmonic2 = (input >= 0.0f) ? harmonic2 : -harmonic2;
+
+    return harmonic2 + harmonic3;
+  }
+
+  float processTransient(float input, float &envelope, float drive) const {
+    using namespace VT2BGoldenConstants;
+
+    float absInput = std::abs(input);
+
+    float attackCoeff =
+        1.0f - std::exp(-1.0f / (float(currentSampleRate) * kEnvelopeAttack));
+    float releaseCoeff =
+        1.0f - std::exp(-1.0f / (float(currentSampleRate) * kEnvelopeRelease));
+
+    if (absInput > envelope)
+      envelope = envelope + attackCoeff * (absInput - envelope);
+    else
+      envelope = envelope + releaseCoeff * (absInput - envelope);
+
+    float normalizedDrive = drive / kDriveMax;
+    float amount = kTransientAmountMin +
+                   normalizedDrive * (kTransientAmountMax - kTransientAmountMin);
+
+    float reduction = 0.0f;
+    if (envelope > kTransientThreshold) {
+      float excess = (envelope - kTransientThreshold) / kTransientKnee;
+      reduction = std::min(1.0f, excess) * amount;
+    }
+
+    return input * (1.0f - reduction);
+  }
+
+  float calculateMakeupGain(float drive) const {
+    float normalizedDrive = drive / VT2BGoldenConstants::kDriveMax;
+    return 1.0f / (1.0f + normalizedDrive * 0.8f);
+  }
+
+  double currentSampleRate = 44100.0;
+  VT2BSmoothedValue smoothedDrive;
+  VT2BSmoothedValue smoothedMix;
+  std::vector<float> envelopes;
+};
@@ -0,0 +1,412 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Realtime Safety Hooks
+
+    確保・ロック・ブロックする呼び出しを横取りし、VT2BRealtimeCheck::report
+    に渡す。VT2BRealtimeSafetyTest の実行ファイルにだけ入れる（プラグインや
+    DSP ライブラリには入れない）。
+
+    operator new / delete の置き換えと libc の関数の横取りは、定義が実行
+    ファイルにあるときだけ効く。dlopen で読み込まれる VST3 / AU の中に置いても
+    ホスト側（実行ファイル・libc）の定義が先に解決されるので、プラグインの
+    検査には使えない。
+  ==============================================================================
+*/
+
+#include "dsp/VT2BRealtimeCheck.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if !VT2B_REALTIME_CHECKS
+#error "VT2BRealtimeHooks.cpp needs VT2B_REALTIME_CHECKS=1 (EA_VT_2B_REALTIME_CHECKS)"
+#endif
+
+// glibc では malloc 系と pthread / ブロックする呼び出しも横取りする
+// （実行ファイル側の定義が libc より先に解決される）。ほかの環境では
+// operator new / delete だけ
+#if defined(__GLIBC__)
+#define VT2B_REALTIME_HOOK_LIBC 1
+#include <dlfcn.h>
+#include <poll.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+#include <unistd.h>
+#else
+#define VT2B_REALTIME_HOOK_LIBC 0
+#endif
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+//==============================================================================
+// 確保の横取り（operator new / delete は全環境、malloc 系は glibc のみ）
+
+#if VT2B_REALTIME_HOOK_LIBC
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *pointer, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *pointer);
+}
+#endif
+
+namespace {
+using VT2BRealtimeCheck::report;
+
+void *rawAllocate(size_t size) {
+#if VT2B_REALTIME_HOOK_LIBC
+  return __libc_malloc(size);
+#else
+  return std::malloc(size);
+#endif
+}
+
+void rawFree(void *pointer) {
+#if VT2B_REALTIME_HOOK_LIBC
+  __libc_free(pointer);
+#else
+  std::free(pointer);
+#endif
+}
+
+void *rawAllocateAligned(size_t size, size_t alignment) {
+  if (alignment < sizeof(void *))
+    alignment = sizeof(void *);
+
+#if VT2B_REALTIME_HOOK_LIBC
+  return __libc_memalign(alignment, size);
+#elif defined(_MSC_VER)
+  return _aligned_malloc(size, alignment);
+#else
+  void *pointer = nullptr;
+  return posix_memalign(&pointer, alignment, size) == 0 ? pointer : nullptr;
+#endif
+}
+
+void rawFreeAligned(void *pointer) {
+#if defined(_MSC_VER)
+  _aligned_free(pointer);
+#else
+  rawFree(pointer);
+#endif
+}
+
+void *allocate(size_t size, const char *function) {
+  report(VT2BRealtimeViolation::Allocation, function);
+  return rawAllocate(size == 0 ? 1 : size);
+}
+
+void *allocateAligned(size_t size, std::align_val_t alignment,
+                      const char *function) {
+  report(VT2BRealtimeViolation::Allocation, function);
+  return rawAllocateAligned(size == 0 ? 1 : size, (size_t)alignment);
+}
+
+void deallocate(void *pointer, const char *function) {
+  if (pointer == nullptr)
+    return;
+
+  report(VT2BRealtimeViolation::Deallocation, function);
+  rawFree(pointer);
+}
+
+void deallocateAligned(void *pointer, const char *function) {
+  if (pointer == nullptr)
+    return;
+
+  report(VT2BRealtimeViolation::Deallocation, function);
+  rawFreeAligned(pointer);
+}
+
+void *checkAllocated(void *pointer) {
+  if (pointer == nullptr)
+    throw std::bad_alloc();
+
+  return pointer;
+}
+} // namespace
+
+void *operator new(size_t size) {
+  return checkAllocated(allocate(size, "operator new"));
+}
+
+void *operator new[](size_t size) {
+  return checkAllocated(allocate(size, "operator new[]"));
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  return allocate(size, "operator new");
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  return allocate(size, "operator new[]");
+}
+
+void *operator new(size_t size, std::align_val_t alignment) {
+  return checkAllocated(allocateAligned(size, alignment, "operator new"));
+}
+
+void *operator new[](size_t size, std::align_val_t alignment) {
+  return checkAllocated(allocateAligned(size, alignment, "operator new[]"));
+}
+
+void *operator new(size_t size, std::align_val_t alignment,
+                   const std::nothrow_t &) noexcept {
+  return allocateAligned(size, alignment, "operator new");
+}
+
+void *operator new[](size_t size, std::align_val_t alignment,
+                     const std::nothrow_t &) noexcept {
+  return allocateAligned(size, alignment, "operator new[]");
+}
+
+void operator delete(void *pointer) noexcept {
+  deallocate(pointer, "operator delete");
+}
+
+void operator delete[](void *pointer) noexcept {
+  deallocate(pointer, "operator delete[]");
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+  deallocate(pointer, "operator delete");
+}
+
+void operator delete[](void *pointer, size_t) noexcept {
+  deallocate(pointer, "operator delete[]");
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+  deallocate(pointer, "operator delete");
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept {
+  deallocate(pointer, "operator delete[]");
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept {
+  deallocateAligned(pointer, "operator delete");
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept {
+  deallocateAligned(pointer, "operator delete[]");
+}
+
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept {
+  deallocateAligned(pointer, "operator delete");
+}
+
+void operator delete[](void *pointer, size_t, std::align_val_t) noexcept {
+  deallocateAligned(pointer, "operator delete[]");
+}
+
+void operator delete(void *pointer, std::align_val_t,
+                     const std::nothrow_t &) noexcept {
+  deallocateAligned(pointer, "operator delete");
+}
+
+void operator delete[](void *pointer, std::align_val_t,
+                       const std::nothrow_t &) noexcept {
+  deallocateAligned(pointer, "operator delete[]");
+}
+
+#if VT2B_REALTIME_HOOK_LIBC
+//==============================================================================
+// glibc: malloc 系（JUCE の HeapBlock など）
+
+extern "C" {
+void *malloc(size_t size) noexcept {
+  report(VT2BRealtimeViolation::Allocation, "malloc");
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) noexcept {
+  report(VT2BRealtimeViolation::Allocation, "calloc");
+  return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size) noexcept {
+  report(VT2BRealtimeViolation::Allocation, "realloc");
+  return __libc_realloc(pointer, size);
+}
+
+void free(void *pointer) noexcept {
+  if (pointer != nullptr)
+    report(VT2BRealtimeViolation::Deallocation, "free");
+
+  __libc_free(pointer);
+}
+
+int posix_memalign(void **pointer, size_t alignment, size_t size) noexcept {
+  report(VT2BRealtimeViolation::Allocation, "posix_memalign");
+
+  if (alignment < sizeof(void *) || (alignment & (alignment - 1)) != 0)
+    return 22; // EINVAL
+
+  void *allocated = __libc_memalign(alignment, size);
+
+  if (allocated == nullptr)
+    return 12; // ENOMEM
+
+  *pointer = allocated;
+  return 0;
+}
+
+void *aligned_alloc(size_t alignment, size_t size) noexcept {
+  report(VT2BRealtimeViolation::Allocation, "aligned_alloc");
+  return __libc_memalign(alignment, size);
+}
+
+void *memalign(size_t alignment, size_t size) noexcept {
+  report(VT2BRealtimeViolation::Allocation, "memalign");
+  return __libc_memalign(alignment, size);
+}
+}
+
+//==============================================================================
+// glibc: ロックとブロックする呼び出し（本来の関数は RTLD_NEXT で引く）
+
+namespace {
+enum RealFunction {
+  kMutexLock,
+  kRwlockRdlock,
+  kRwlockWrlock,
+  kSemWait,
+  kCondWait,
+  kCondTimedwait,
+  kJoin,
+  kNanosleep,
+  kClockNanosleep,
+  kUsleep,
+  kSleep,
+  kRead,
+  kWrite,
+  kPoll,
+  kNumRealFunctions
+};
+
+const char *const realFunctionNames[kNumRealFunctions] = {
+    "pthread_mutex_lock", "pthread_rwlock_rdlock",  "pthread_rwlock_wrlock",
+    "sem_wait",           "pthread_cond_wait",      "pthread_cond_timedwait",
+    "pthread_join",       "nanosleep",              "clock_nanosleep",
+    "usleep",             "sleep",                  "read",
+    "write",              "poll"};
+
+std::atomic<void *> realFunctions[kNumRealFunctions];
+
+// 起動時に全部引いておく（区間内の初回呼び出しで dlsym が確保しないように）。
+// コンストラクタより前の呼び出しはその場で引く
+template <typename Function> Function getReal(RealFunction function) {
+  void *address = realFunctions[function].load(std::memory_order_relaxed);
+
+  if (address == nullptr) {
+    address = dlsym(RTLD_NEXT, realFunctionNames[function]);
+    realFunctions[function].store(address, std::memory_order_relaxed);
+  }
+
+  return (Function)address;
+}
+
+__attribute__((constructor)) void resolveRealFunctions() {
+  for (int i = 0; i < kNumRealFunctions; ++i)
+    getReal<void *>((RealFunction)i);
+}
+
+void reportLock(RealFunction function) {
+  report(VT2BRealtimeViolation::Lock, realFunctionNames[function]);
+}
+
+void reportBlocking(RealFunction function) {
+  report(VT2BRealtimeViolation::BlockingCall, realFunctionNames[function]);
+}
+} // namespace
+
+extern "C" {
+int pthread_mutex_lock(pthread_mutex_t *mutex) noexcept {
+  reportLock(kMutexLock);
+  return getReal<int (*)(pthread_mutex_t *)>(kMutexLock)(mutex);
+}
+
+int pthread_rwlock_rdlock(pthread_rwlock_t *lock) noexcept {
+  reportLock(kRwlockRdlock);
+  return getReal<int (*)(pthread_rwlock_t *)>(kRwlockRdlock)(lock);
+}
+
+int pthread_rwlock_wrlock(pthread_rwlock_t *lock) noexcept {
+  reportLock(kRwlockWrlock);
+  return getReal<int (*)(pthread_rwlock_t *)>(kRwlockWrlock)(lock);
+}
+
+int sem_wait(sem_t *semaphore) {
+  reportLock(kSemWait);
+  return getReal<int (*)(sem_t *)>(kSemWait)(semaphore);
+}
+
+int pthread_cond_wait(pthread_cond_t *condition, pthread_mutex_t *mutex) {
+  reportBlocking(kCondWait);
+  return getReal<int (*)(pthread_cond_t *, pthread_mutex_t *)>(kCondWait)(
+      condition, mutex);
+}
+
+int pthread_cond_timedwait(pthread_cond_t *condition, pthread_mutex_t *mutex,
+                           const struct timespec *time) {
+  reportBlocking(kCondTimedwait);
+  return getReal<int (*)(pthread_cond_t *, pthread_mutex_t *,
+                         const struct timespec *)>(kCondTimedwait)(condition,
+                                                                   mutex, time);
+}
+
+int pthread_join(pthread_t thread, void **result) {
+  reportBlocking(kJoin);
+  return getReal<int (*)(pthread_t, void **)>(kJoin)(thread, result);
+}
+
+int nanosleep(const struct timespec *duration, struct timespec *remaining) {
+  reportBlocking(kNanosleep);
+  return getReal<int (*)(const struct timespec *, struct timespec *)>(
+      kNanosleep)(duration, remaining);
+}
+
+int clock_nanosleep(clockid_t clock, int flags, const struct timespec *time,
+                    struct timespec *remaining) {
+  reportBlocking(kClockNanosleep);
+  return getReal<int (*)(clockid_t, int, const struct timespec *,
+                         struct timespec *)>(kClockNanosleep)(clock, flags,
+                                                              time, remaining);
+}
+
+int usleep(useconds_t microseconds) {
+  reportBlocking(kUsleep);
+  return getReal<int (*)(useconds_t)>(kUsleep)(microseconds);
+}
+
+unsigned int sleep(unsigned int seconds) {
+  reportBlocking(kSleep);
+  return getReal<unsigned int (*)(unsigned int)>(kSleep)(seconds);
+}
+
+ssize_t read(int descriptor, void *buffer, size_t size) {
+  reportBlocking(kRead);
+  return getReal<ssize_t (*)(int, void *, size_t)>(kRead)(descriptor, buffer,
+                                                         size);
+}
+
+ssize_t write(int descriptor, const void *buffer, size_t size) {
+  reportBlocking(kWrite);
+  return getReal<ssize_t (*)(int, const void *, size_t)>(kWrite)(descriptor,
+                                                                buffer, size);
+}
+
+int poll(struct pollfd *descriptors, nfds_t count, int timeout) {
+  reportBlocking(kPoll);
+  return getReal<int (*)(struct pollfd *, nfds_t, int)>(kPoll)(descriptors,
+                                                              count, timeout);
+}
+}
+#endif // VT2B_REALTIME_HOOK_LIBC
@@ -0,0 +1,283 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Realtime Safety Test
+
+    プロセッサー（VT2BBlackProcessor）を実際の使われ方に近い順序で動かし、
+    processBlock の区間でヒープ確保・ロック・ブロックする呼び出しが一度も
+    起きないことを確かめる（VT2B_REALTIME_CHECKS を有効にしたビルド専用）。
+
+      シナリオ: prepareToPlay → Drive / Mix のオートメーション（不規則な
+                ブロック長）→ オーバーサンプリング・フィルタ・ADAA の切り替え →
+                検出器のリンク・バイパス → 倍精度 → 状態の保存と復元 →
+                サンプルレートとブロック長の変更
+      メーター・解析は有効にしておく（エディターを開いている状態）
+
+    違反があれば関数名を列挙して終了コード 1 を返す。
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "dsp/VT2BRealtimeCheck.h"
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#if !VT2B_REALTIME_CHECKS
+#error "VT2BRealtimeSafetyTest needs VT2B_REALTIME_CHECKS=1 (EA_VT_2B_REALTIME_CHECKS)"
+#endif
+
+namespace {
+// ホストのブロック長（この順に繰り返す、最大はブロック長の上限以下に切る）
+const int kBlockSizes[] = {512, 1, 7, 64, 113, 3, 256, 2, 500, 65};
+
+struct Configuration {
+  double sampleRate;
+  int blockSize;
+};
+
+const Configuration kConfigurations[] = {
+    {48000.0, 512}, {44100.0, 256}, {96000.0, 1024}, {192000.0, 64}};
+
+//==============================================================================
+class RealtimeSafetyTest {
+public:
+  RealtimeSafetyTest() : processor(std::make_unique<VT2BBlackProcessor>()) {}
+
+  bool run() {
+    if (!checkDetector())
+      return false;
+
+    bool passed = true;
+
+    for (const auto &configuration : kConfigurations) {
+      prepare(configuration);
+
+      // エディターを開いている状態（メーター・解析が動く）
+      processor->getTelemetry().setActive(true);
+      processor->getAnalyzer().setActive(true);
+
+      passed &= runScenario("automation", [this] { sweepDriveAndMix(); });
+      passed &= runScenario("alias reduction", [this] { switchAliasReduction(); });
+      passed &= runScenario("link / bypass", [this] { switchLinkAndBypass(); });
+      passed &= runScenario("double precision", [this] { processDouble(); });
+      passed &= runScenario("state", [this] { restoreState(); });
+
+      processor->getAnalyzer().setActive(false);
+      processor->getTelemetry().setActive(false);
+    }
+
+    return passed;
+  }
+
+private:
+  /** 検査が効いているか（区間内の確保を数えるか）を先に確かめる */
+  bool checkDetector() {
+    VT2BRealtimeCheck::resetViolations();
+
+    {
+      VT2B_REALTIME_SCOPE();
+      std::vector<float> allocated((size_t)processor->getTotalNumInputChannels());
+      juce::ignoreUnused(allocated.data());
+    }
+
+    const bool detected =
+        VT2BRealtimeCheck::getNumViolations(VT2BRealtimeViolation::Allocation) > 0;
+    VT2BRealtimeCheck::resetViolations();
+
+    std::printf("detector self-check: %s\n", detected ? "ok" : "FAILED");
+    return detected;
+  }
+
+  void prepare(const Configuration &configuration) {
+    current = configuration;
+    processor->releaseResources();
+    processor->setRateAndBufferSizeDetails(configuration.sampleRate,
+                                           configuration.blockSize);
+    processor->prepareToPlay(configuration.sampleRate, configuration.blockSize);
+
+    floatBuffer.setSize(processor->getTotalNumInputChannels(),
+                        configuration.blockSize);
+    doubleBuffer.setSize(processor->getTotalNumInputChannels(),
+                         configuration.blockSize);
+    blockIndex = 0;
+    phase = 0.0;
+  }
+
+  template <typename Scenario>
+  bool runScenario(const char *name, Scenario &&scenario) {
+    VT2BRealtimeCheck::resetViolations();
+    scenario();
+
+    const uint64_t violations = VT2BRealtimeCheck::getNumViolations();
+    std::printf("%6.0f Hz / %4d  %-18s %s\n", current.sampleRate,
+                current.blockSize, name, violations == 0 ? "ok" : "FAILED");
+
+    if (violations == 0)
+      return true;
+
+    const char *functions[VT2BRealtimeCheck::kMaxRecorded];
+    VT2BRealtimeViolation types[VT2BRealtimeCheck::kMaxRecorded];
+    const int numRecorded = VT2BRealtimeCheck::getRecorded(
+        functions, types, VT2BRealtimeCheck::kMaxRecorded);
+
+    std::printf("  %llu violations\n", (unsigned long long)violations);
+    for (int i = 0; i < numRecorded; ++i)
+      std::printf("  %s: %s\n", VT2BRealtimeCheck::getName(types[i]),
+                  functions[i]);
+
+    return false;
+  }
+
+  //==============================================================================
+  // 1 ブロック（ブロック長は kBlockSizes の順、信号は 220 Hz の正弦波）
+
+  template <typename SampleType>
+  void processNext(juce::AudioBuffer<SampleType> &buffer, bool bypassed = false) {
+    const int numSamples =
+        juce::jmin(kBlockSizes[blockIndex++ % std::size(kBlockSizes)],
+                   current.blockSize);
+    buffer.setSize(buffer.getNumChannels(), numSamples, false, false, true);
+
+    const double increment =
+        juce::MathConstants<double>::twoPi * 220.0 / current.sampleRate;
+
+    for (int i = 0; i < numSamples; ++i) {
+      const auto sample = (SampleType)(0.5 * std::sin(phase));
+      for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        buffer.setSample(channel, i, sample);
+      phase += increment;
+    }
+
+    if (bypassed)
+      processor->processBlockBypassed(buffer, midi);
+    else
+      processor->processBlock(buffer, midi);
+  }
+
+  void processBlocks(int numBlocks) {
+    for (int i = 0; i < numBlocks; ++i)
+      processNext(floatBuffer);
+  }
+
+  /** 設定変更を拾うタイマー（待機側のエンジンの準備）を走らせる */
+  void dispatchMessages() {
+    juce::MessageManager::getInstance()->runDispatchLoopUntil(50);
+  }
+
+  void setParameter(const char *id, float normalisedValue) {
+    auto *parameter = processor->getParameters().getParameter(id);
+    parameter->beginChangeGesture();
+    parameter->setValueNotifyingHost(normalisedValue);
+    parameter->endChangeGesture();
+  }
+
+  //==============================================================================
+  void sweepDriveAndMix() {
+    for (int step = 0; step <= 100; ++step) {
+      setParameter("drive", (float)step / 100.0f);
+      setParameter("mix", 1.0f - (float)(step % 25) / 25.0f);
+      processBlocks(3);
+    }
+  }
+
+  void switchAliasReduction() {
+    for (int oversampling = 0; oversampling < 4; ++oversampling) {
+      for (int filter = 0; filter < 2; ++filter) {
+        for (int antialiasing = 0; antialiasing < 3; ++antialiasing) {
+          setParameter("oversampling", (float)oversampling / 3.0f);
+          setParameter("oversamplingFilter", (float)filter);
+          setParameter("antialiasing", (float)antialiasing / 2.0f);
+          processBlocks(4); // 待機側の準備前（古い設定のまま）
+          dispatchMessages();
+          processBlocks(12); // 新旧のエンジンのクロスフェード
+        }
+      }
+    }
+
+    setParameter("oversampling", 0.0f);
+    setParameter("antialiasing", 0.0f);
+    dispatchMessages();
+  }
+
+  void switchLinkAndBypass() {
+    for (int link = 0; link < 3; ++link) {
+      setParameter("envelopeLink", (float)link / 2.0f);
+      processBlocks(10);
+    }
+
+    for (int toggle = 0; toggle < 6; ++toggle) {
+      setParameter("bypass", (float)(toggle % 2));
+      processBlocks(20); // クロスフェードをまたぐ
+    }
+
+    for (int i = 0; i < 20; ++i)
+      processNext(floatBuffer, true);
+
+    setParameter("bypass", 0.0f);
+    processBlocks(20);
+  }
+
+  void processDouble() {
+    processor->setProcessingPrecision(juce::AudioProcessor::doublePrecision);
+
+    for (int i = 0; i < 50; ++i)
+      processNext(doubleBuffer, i % 10 == 9);
+
+    processor->setProcessingPrecision(juce::AudioProcessor::singlePrecision);
+  }
+
+  void restoreState() {
+    juce::MemoryBlock saved;
+    processor->getStateInformation(saved);
+
+    setParameter("drive", 0.8f);
+    setParameter("oversampling", 1.0f / 3.0f);
+    processBlocks(10);
+
+    // 別の値の状態を読み込んでから元に戻す（どちらも再生中に行う）
+    juce::MemoryBlock altered;
+    processor->getStateInformation(altered);
+    processor->setStateInformation(saved.getData(), (int)saved.getSize());
+    processBlocks(10);
+    dispatchMessages();
+    processBlocks(10);
+
+    processor->setStateInformation(altered.getData(), (int)altered.getSize());
+    processBlocks(10);
+    dispatchMessages();
+    processBlocks(10);
+
+    processor->setStateInformation(saved.getData(), (int)saved.getSize());
+    dispatchMessages();
+    processBlocks(10);
+  }
+
+  std::unique_ptr<VT2BBlackProcessor> processor;
+  Configuration current{};
+  juce::AudioBuffer<float> floatBuffer;
+  juce::AudioBuffer<double> doubleBuffer;
+  juce::MidiBuffer midi;
+  size_t blockIndex = 0;
+  double phase = 0.0;
+};
+} // namespace
+
+//==============================================================================
+int main() {
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+  bool passed = false;
+  {
+    RealtimeSafetyTest test;
+    passed = test.run();
+  }
+
+  std::printf("%s\n", passed ? "PASSED" : "FAILED");
+  return passed ? 0 : 1;
+}
@@ -37,6 +37,7 @@ void VT2BImageKnob::setImage(const juce::Image &image) {
 }
 
 void VT2BImageKnob::paint(juce::Graphics &g) {
+  VT2B_TRACE_SCOPE("ui", "VT2BImageKnob::paint");
   auto bounds = getLocalBounds().toFloat();
   auto centre = bounds.getCentre();
 
@@ -186,6 +187,184 @@ void VT2BImageKnob::mouseWheelMove(const juce::MouseEvent &,
   setValue(value + delta);
 }
 
+//==============================================================================
+// VT2BLevelMeter Implementation
+//==============================================================================
+
+VT2BLevelMeter::VT2BLevelMeter() {
+  setInterceptsMouseClicks(false, false);
+  setOpaque(false);
+}
+
+void VT2BLevelMeter::update(const VT2BMeterFrame &frame, bool hasNewFrame) {
+  auto toDb = [](float gain) {
+    return juce::jmax(kLevelFloorDb,
+                      juce::Decibels::gainToDecibels(gain, kLevelFloorDb));
+  };
+
+  // 上がるときは即座に、下がるときは kReleaseDbPerUpdate ずつ
+  auto follow = [](float &displayed, float target) {
+    displayed = juce::jmax(target, displayed - kReleaseDbPerUpdate);
+  };
+
+  const VT2BMeterFrame silence;
+  const auto &source = hasNewFrame ? frame : silence;
+
+  follow(inputRmsDb, toDb(source.inputRms));
+  follow(inputPeakDb, toDb(source.inputPeak));
+  follow(outputRmsDb, toDb(source.outputRms));
+  follow(outputPeakDb, toDb(source.outputPeak));
+  follow(gainReductionDb,
+         juce::jmin(kGainReductionRangeDb,
+                    -juce::Decibels::gainToDecibels(source.gainReduction,
+                                                    -kGainReductionRangeDb)));
+
+  repaint();
+}
+
+void VT2BLevelMeter::paint(juce::Graphics &g) {
+  auto bounds = getLocalBounds().toFloat();
+  const float rowHeight = bounds.getHeight() / 3.0f;
+
+  g.setFont(12.0f);
+
+  drawLevel(g, bounds.removeFromTop(rowHeight), "IN", inputRmsDb,
+            inputPeakDb);
+
+  // ゲインリダクション（左から伸びる）
+  auto row = bounds.removeFromTop(rowHeight).reduced(0.0f, 4.0f);
+  g.setColour(juce::Colour(0xffc8a46e));
+  g.drawText("GR", row.removeFromLeft(32.0f), juce::Justification::centredLeft);
+
+  g.setColour(juce::Colours::black.withAlpha(0.5f));
+  g.fillRoundedRectangle(row, 2.0f);
+
+  g.setColour(juce::Colour(0xffd08a3c));
+  g.fillRoundedRectangle(
+      row.withWidth(row.getWidth() * gainReductionDb / kGainReductionRangeDb),
+      2.0f);
+
+  drawLevel(g, bounds, "OUT", outputRmsDb, outputPeakDb);
+}
+
+void VT2BLevelMeter::drawLevel(juce::Graphics &g, juce::Rectangle<float> area,
+                               const juce::String &name, float rmsDb,
+                               float peakDb) const {
+  auto row = area.reduced(0.0f, 4.0f);
+
+  g.setColour(juce::Colour(0xffc8a46e));
+  g.drawText(name, row.removeFromLeft(32.0f),
+             juce::Justification::centredLeft);
+
+  g.setColour(juce::Colours::black.withAlpha(0.5f));
+  g.fillRoundedRectangle(row, 2.0f);
+
+  auto toProportion = [](float db) {
+    return juce::jlimit(0.0f, 1.0f, 1.0f - db / kLevelFloorDb);
+  };
+
+  // RMS（バー）
+  g.setColour(juce::Colour(0xff3fa9c0));
+  g.fillRoundedRectangle(row.withWidth(row.getWidth() * toProportion(rmsDb)),
+                         2.0f);
+
+  // ピーク（細線、0 dBFS 以上は赤）
+  const float peakX = row.getX() + row.getWidth() * toProportion(peakDb);
+  g.setColour(peakDb >= 0.0f ? juce::Colours::red
+                             : juce::Colour(0xffe8d8b8));
+  g.fillRect(juce::Rectangle<float>(peakX - 1.0f, row.getY(), 2.0f,
+                                    row.getHeight()));
+}
+
+//==============================================================================
+// VT2BAnalyzerView Implementation
+//==============================================================================
+
+void VT2BAnalyzerView::setResults(const VT2BAnalysisResults &newResults) {
+  results = newResults;
+  repaint();
+}
+
+void VT2BAnalyzerView::paint(juce::Graphics &g) {
+  auto bounds = getLocalBounds().toFloat();
+
+  g.setColour(juce::Colours::black.withAlpha(0.85f));
+  g.fillRoundedRectangle(bounds, 4.0f);
+
+  auto area = bounds.reduced(8.0f);
+  const auto header = area.removeFromTop(18.0f);
+
+  // 目盛り（100 Hz / 1 kHz / 10 kHz、-30 / -60 dBFS）
+  g.setColour(juce::Colours::white.withAlpha(0.1f));
+
+  for (const float frequency : {100.0f, 1000.0f, 10000.0f})
+    g.drawVerticalLine(
+        juce::roundToInt(area.getX() + area.getWidth() *
+                                           std::log(frequency / 20.0f) /
+                                           std::log(1000.0f)),
+        area.getY(), area.getBottom());
+
+  for (const float level : {-30.0f, -60.0f})
+    g.drawHorizontalLine(
+        juce::roundToInt(juce::jmap(level, kSpectrumFloorDb, 0.0f,
+                                    area.getBottom(), area.getY())),
+        area.getX(), area.getRight());
+
+  // スペクトル（処理前 → 処理後の順に重ねる）
+  g.setColour(juce::Colours::grey.withAlpha(0.8f));
+  g.strokePath(createSpectrumPath(results.preSpectrumDb, area),
+               juce::PathStrokeType(1.0f));
+
+  g.setColour(juce::Colour(0xffc8a46e));
+  g.strokePath(createSpectrumPath(results.postSpectrumDb, area),
+               juce::PathStrokeType(1.5f));
+
+  // ラウドネス
+  auto format = [](float lufs) {
+    return lufs <= VT2BAnalysisResults::kFloorDb ? juce::String("-inf")
+                                                 : juce::String(lufs, 1);
+  };
+
+  g.setFont(12.0f);
+  g.drawText("M " + format(results.momentaryLufs) + "  S " +
+                 format(results.shortTermLufs) + "  I " +
+                 format(results.integratedLufs) + " LUFS",
+             header, juce::Justification::centredLeft);
+
+  if (results.droppedSamples > 0) {
+    g.setColour(juce::Colours::orange);
+    g.drawText("dropped " + juce::String((juce::uint64)results.droppedSamples) +
+                   " samples",
+               header, juce::Justification::centredRight);
+  }
+}
+
+void VT2BAnalyzerView::mouseDoubleClick(const juce::MouseEvent &) {
+  if (onResetLoudness)
+    onResetLoudness();
+}
+
+juce::Path VT2BAnalyzerView::createSpectrumPath(
+    const std::array<float, VT2BAnalysisResults::kNumBands> &spectrumDb,
+    juce::Rectangle<float> area) const {
+  juce::Path path;
+
+  for (int band = 0; band < VT2BAnalysisResults::kNumBands; ++band) {
+    const float x = area.getX() + area.getWidth() * ((float)band + 0.5f) /
+                                      (float)VT2BAnalysisResults::kNumBands;
+    const float y = juce::jmap(
+        juce::jlimit(kSpectrumFloorDb, 0.0f, spectrumDb[(size_t)band]),
+        kSpectrumFloorDb, 0.0f, area.getBottom(), area.getY());
+
+    if (band == 0)
+      path.startNewSubPath(x, y);
+    else
+      path.lineTo(x, y);
+  }
+
+  return path;
+}
+
 //==============================================================================
 // VT2BBlackEditor Implementation
 //==============================================================================
@@ -217,6 +396,17 @@ VT2BBlackEditor::VT2BBlackEditor(VT2BBlackProcessor &p)
   mixKnob.setRotationRange(-2.35619f, 2.35619f);
   addAndMakeVisible(mixKnob);
 
+  // メーター（エディターが開いている間だけプロセッサがフレームを積む）
+  addAndMakeVisible(levelMeter);
+  audioProcessor.getTelemetry().setActive(true);
+  meterTimer.startTimerHz(30);
+
+  // 解析表示（真空管の窓に重ねる、初期状態は閉じる）
+  analyzerView.onResetLoudness = [this] {
+    audioProcessor.getAnalyzer().resetLoudness();
+  };
+  addChildComponent(analyzerView);
+
   // 内部スライダー（アタッチメント用）
   driveSlider.setRange(0.0, 10.0);
   mixSlider.setRange(0.0, 100.0);
@@ -246,9 +436,16 @@ VT2BBlackEditor::VT2BBlackEditor(VT2BBlackProcessor &p)
   mixAttachment =
       std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
           audioProcessor.getParameters(), "mix", mixSlider);
+
+#if VT2B_ENABLE_PROFILER
+  profilerTimer.startTimerHz(4);
+#endif
 }
 
 VT2BBlackEditor::~VT2BBlackEditor() {
+  audioProcessor.getTelemetry().setActive(false);
+  audioProcessor.getAnalyzer().setActive(false);
+
   // アタッチメントを先に解放してクラッシュを防止
   driveAttachment.reset();
   mixAttachment.reset();
@@ -264,6 +461,7 @@ void VT2BBlackEditor::loadImages() {
 }
 
 void VT2BBlackEditor::paint(juce::Graphics &g) {
+  VT2B_TRACE_SCOPE("ui", "VT2BBlackEditor::paint");
   // 背景画像を描画
   if (backgroundImage.isValid()) {
     g.drawImage(backgroundImage, getLocalBounds().toFloat());
@@ -289,6 +487,89 @@ void VT2BBlackEditor::paint(juce::Graphics &g) {
                         ") | Size: " + juce::String(g_debugKnobSize);
   g.drawText(values, 10, 30, getWidth() - 20, 20, juce::Justification::left);
 #endif
+
+#if VT2B_ENABLE_PROFILER
+  // 処理時間: ブロックの締め切りに対する %（p50 / p99 / p99.9 / 最大）
+  const auto summary = audioProcessor.getProfiler().getSummary();
+  const auto &deadline = summary.deadlineFraction;
+
+  g.setColour(juce::Colours::yellow);
+  g.setFont(12.0f);
+
+  juce::String cpu =
+      "CPU p50 " + juce::String(deadline.p50 * 100.0, 2) + "% | p99 " +
+      juce::String(deadline.p99 * 100.0, 2) + "% | p99.9 " +
+      juce::String(deadline.p999 * 100.0, 2) + "% | max " +
+      juce::String(deadline.max * 100.0, 2) + "% | p99 " +
+      juce::String(summary.nsPerSample.p99, 1) + " ns/sample | " +
+      juce::String((juce::uint64)summary.numBlocks) + " blocks";
+  auto profilerBounds = getProfilerBounds();
+  g.drawText(cpu, profilerBounds.removeFromTop(16), juce::Justification::left);
+
+  if (profilerStatus.isNotEmpty())
+    g.drawText(profilerStatus, profilerBounds.withTrimmedTop(2),
+               juce::Justification::left);
+#endif
+}
+
+#if VT2B_ENABLE_PROFILER
+void VT2BBlackEditor::mouseDoubleClick(const juce::MouseEvent &event) {
+  auto &profiler = audioProcessor.getProfiler();
+
+  if (event.mods.isAltDown()) {
+    profiler.reset();
+    profilerStatus = "Profile reset";
+  } else {
+    const auto file =
+        juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+            .getNonexistentChildFile("EA VT-2B Profile", ".txt");
+
+    profilerStatus = file.replaceWithText(profiler.getReport())
+                         ? "Saved: " + file.getFullPathName()
+                         : "Cannot write: " + file.getFullPathName();
+  }
+
+  repaint(getProfilerBounds());
+}
+#endif
+
+void VT2BBlackEditor::updateMeter() {
+  // 溜まったフレームをまとめる（ピークとリダクションは最悪値、RMS は最新）
+  VT2BMeterFrame latest, frame;
+  bool hasNewFrame = false;
+
+  while (audioProcessor.getTelemetry().pop(frame)) {
+    if (hasNewFrame) {
+      frame.inputPeak = juce::jmax(frame.inputPeak, latest.inputPeak);
+      frame.outputPeak = juce::jmax(frame.outputPeak, latest.outputPeak);
+      frame.gainReduction =
+          juce::jmin(frame.gainReduction, latest.gainReduction);
+    }
+
+    latest = frame;
+    hasNewFrame = true;
+  }
+
+  levelMeter.update(latest, hasNewFrame);
+}
+
+void VT2BBlackEditor::updateAnalyzerView() {
+  VT2BAnalysisResults results;
+
+  if (analyzerView.isVisible() &&
+      audioProcessor.getAnalyzer().getLatestResults(results))
+    analyzerView.setResults(results);
+}
+
+void VT2BBlackEditor::mouseDown(const juce::MouseEvent &event) {
+  // ロゴ（EA）のクリックで解析表示を開閉する
+  if (event.position.getDistanceFrom({512.0f, 500.0f}) < 85.0f)
+    setAnalyzerVisible(!analyzerView.isVisible());
+}
+
+void VT2BBlackEditor::setAnalyzerVisible(bool shouldBeVisible) {
+  analyzerView.setVisible(shouldBeVisible);
+  audioProcessor.getAnalyzer().setActive(shouldBeVisible);
 }
 
 void VT2BBlackEditor::resized() {
@@ -305,4 +586,10 @@ void VT2BBlackEditor::resized() {
   driveKnob.setBounds(216 - knobSize / 2, 523, knobSize, knobSize);
   mixKnob.setBounds(809 - knobSize / 2, 523, knobSize, knobSize);
 #endif
+
+  // ロゴの下（ノブの間）
+  levelMeter.setBounds(392, 630, 240, 96);
+
+  // 真空管の窓
+  analyzerView.setBounds(84, 176, 856, 174);
 }
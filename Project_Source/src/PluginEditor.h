@@ -69,6 +69,70 @@ private:
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VT2BImageKnob)
 };
 
+//==============================================================================
+/**
+ * メーター - 入力・ゲインリダクション・出力の横バー
+ *
+ * レベルは RMS をバー、ピークを細線で表示する（-60〜0 dBFS）。
+ * ゲインリダクションはトランジェント整形の抑制量（0〜12 dB）。
+ */
+class VT2BLevelMeter : public juce::Component {
+public:
+  VT2BLevelMeter();
+
+  void paint(juce::Graphics &g) override;
+
+  /** 新しいフレームを反映する（減衰は update() の呼び出し間隔に合わせる） */
+  void update(const VT2BMeterFrame &frame, bool hasNewFrame);
+
+private:
+  static constexpr float kLevelFloorDb = -60.0f;
+  static constexpr float kGainReductionRangeDb = 12.0f;
+  static constexpr float kReleaseDbPerUpdate = 1.0f; // 30 Hz で 30 dB/s
+
+  void drawLevel(juce::Graphics &g, juce::Rectangle<float> area,
+                 const juce::String &name, float rmsDb, float peakDb) const;
+
+  float inputRmsDb = kLevelFloorDb;
+  float inputPeakDb = kLevelFloorDb;
+  float outputRmsDb = kLevelFloorDb;
+  float outputPeakDb = kLevelFloorDb;
+  float gainReductionDb = 0.0f;
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VT2BLevelMeter)
+};
+
+//==============================================================================
+/**
+ * 解析表示 - 処理前後のスペクトルとラウドネス
+ *
+ * スペクトルは 20 Hz〜20 kHz・-90〜0 dBFS（処理前: グレー、処理後: ゴールド）。
+ * ダブルクリックでインテグレーテッドを測り直す。
+ */
+class VT2BAnalyzerView : public juce::Component {
+public:
+  VT2BAnalyzerView() = default;
+
+  void paint(juce::Graphics &g) override;
+
+  void setResults(const VT2BAnalysisResults &newResults);
+
+  std::function<void()> onResetLoudness;
+
+private:
+  static constexpr float kSpectrumFloorDb = -90.0f;
+
+  void mouseDoubleClick(const juce::MouseEvent &event) override;
+
+  juce::Path createSpectrumPath(
+      const std::array<float, VT2BAnalysisResults::kNumBands> &spectrumDb,
+      juce::Rectangle<float> area) const;
+
+  VT2BAnalysisResults results;
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VT2BAnalyzerView)
+};
+
 //==============================================================================
 /**
  * メインエディター - 背景画像とノブ画像を使用
@@ -93,6 +157,20 @@ private:
   VT2BImageKnob driveKnob;
   VT2BImageKnob mixKnob;
 
+  // メーターと解析表示（解析表示はロゴのクリックで開閉し、開いている間だけ
+  // 解析スレッドが動く）。どちらもプロセッサのキューをタイマーで読む
+  VT2BLevelMeter levelMeter;
+  VT2BAnalyzerView analyzerView;
+  juce::TimedCallback meterTimer{[this] {
+    updateMeter();
+    updateAnalyzerView();
+  }};
+  void updateMeter();
+  void updateAnalyzerView();
+
+  void mouseDown(const juce::MouseEvent &event) override;
+  void setAnalyzerVisible(bool shouldBeVisible);
+
   // 内部スライダー（アタッチメント用）
   juce::Slider driveSlider;
   juce::Slider mixSlider;
@@ -106,5 +184,18 @@ private:
   // 画像ロード
   void loadImages();
 
+#if VT2B_ENABLE_PROFILER
+  // 処理時間の表示（ダブルクリックでファイルに書き出し、⌥+ダブルクリックでリセット）
+  void mouseDoubleClick(const juce::MouseEvent &event) override;
+
+  juce::String profilerStatus;
+
+  // 処理時間と状態の 2 行（この範囲だけ描き直す）
+  juce::Rectangle<int> getProfilerBounds() const {
+    return {10, getHeight() - 40, getWidth() - 20, 34};
+  }
+  juce::TimedCallback profilerTimer{[this] { repaint(getProfilerBounds()); }};
+#endif
+
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VT2BBlackEditor)
 };
@@ -14,39 +14,8 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
-#include <cmath>
-
-//==============================================================================
-// 定数 - 効果を分かりやすくするために強化
-namespace VT2BConstants {
-// サチュレーション - 効果を強く（ユーザー要望により大幅強化）
-constexpr float kSaturationCoeffMin = 0.0f;
-constexpr float kSaturationCoeffMax = 3.0f; // 0.8 -> 3.0
-constexpr float kSaturationCurve = 2.5f; // 1.5 -> 2.5 硬めのカーブで質感を出す
-
-// 倍音生成 - より明確に
-constexpr float kHarmonic2ndAmount = 0.40f; // 0.15 -> 0.40 (暖かさ)
-constexpr float kHarmonic3rdAmount = 0.25f; // 0.08 -> 0.25 (エッジ)
-
-// トランジェント - 音のアタック感を強調
-constexpr float kTransientThreshold = 0.2f;
-constexpr float kTransientKnee = 0.15f;
-constexpr float kTransientAmountMin = 0.08f;
-constexpr float kTransientAmountMax = 0.50f; // 0.25 -> 0.50
-constexpr float kEnvelopeAttack = 0.001f;
-constexpr float kEnvelopeRelease = 0.050f;
-
-// オールパス（位相安定化）
-constexpr float kAllpassFrequency = 80.0f; // Hz
-
-// パラメータ範囲
-constexpr float kDriveMin = 0.0f;
-constexpr float kDriveMax = 10.0f;
-constexpr float kDriveDefault = 0.0f;
-constexpr float kMixMin = 0.0f;
-constexpr float kMixMax = 100.0f;
-constexpr float kMixDefault = 100.0f;
-} // namespace VT2BConstants
+#include "dsp/VT2BConstants.h"
+#include "dsp/VT2BRealtimeCheck.h"
 
 //==============================================================================
 VT2BBlackProcessor::VT2BBlackProcessor()
@@ -58,9 +27,37 @@ VT2BBlackProcessor::VT2BBlackProcessor()
                  createParameterLayout()) {
   driveParameter = parameters.getRawParameterValue("drive");
   mixParameter = parameters.getRawParameterValue("mix");
+  oversamplingParameter = parameters.getRawParameterValue("oversampling");
+  oversamplingFilterParameter =
+      parameters.getRawParameterValue("oversamplingFilter");
+  antialiasingParameter = parameters.getRawParameterValue("antialiasing");
+  envelopeLinkParameter = parameters.getRawParameterValue("envelopeLink");
+  bypassParameter = parameters.getRawParameterValue("bypass");
+
+  parameters.addParameterListener("oversampling", this);
+  parameters.addParameterListener("oversamplingFilter", this);
+  parameters.addParameterListener("antialiasing", this);
+
+  // 設定の変更を拾う周期（切り替えはその後のクロスフェードで聞こえなくなる）
+  startTimerHz(30);
+
+  // 記録先を先に作っておく（初回の確保をオーディオスレッドで行わない）
+  VT2B_TRACE_THREAD_NAME("message");
 }
 
-VT2BBlackProcessor::~VT2BBlackProcessor() {}
+VT2BBlackProcessor::~VT2BBlackProcessor() {
+  parameters.removeParameterListener("oversampling", this);
+  parameters.removeParameterListener("oversamplingFilter", this);
+  parameters.removeParameterListener("antialiasing", this);
+  stopTimer();
+
+#if VT2B_ENABLE_TRACING
+  // プラグインを閉じるときにトレースを書き出す（直近 kCapacity 件）
+  juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+      .getNonexistentChildFile("EA VT-2B Trace", ".json")
+      .replaceWithText(VT2BTraceRecorder::getInstance().getJson());
+#endif
+}
 
 //==============================================================================
 juce::AudioProcessorValueTreeState::ParameterLayout
@@ -83,6 +80,32 @@ VT2BBlackProcessor::createParameterLayout() {
       VT2BConstants::kMixDefault,
       juce::AudioParameterFloatAttributes().withLabel("%")));
 
+  // Oversampling パラメータ（非線形ステージのみ）
+  params.push_back(std::make_unique<juce::AudioParameterChoice>(
+      juce::ParameterID{"oversampling", 1}, "Oversampling",
+      juce::StringArray{"Off", "2x", "4x", "8x"},
+      VT2BConstants::kOversamplingDefault));
+
+  // Oversampling フィルタ（低レイテンシ / 線形位相）
+  params.push_back(std::make_unique<juce::AudioParameterChoice>(
+      juce::ParameterID{"oversamplingFilter", 1}, "Oversampling Filter",
+      juce::StringArray{"Minimum Phase", "Linear Phase"}, 0));
+
+  // ADAA（オーバーサンプリングより安価な折り返し対策、併用も可）
+  params.push_back(std::make_unique<juce::AudioParameterChoice>(
+      juce::ParameterID{"antialiasing", 1}, "Anti-Aliasing",
+      juce::StringArray{"Off", "ADAA 1st Order", "ADAA 2nd Order"}, 0));
+
+  // トランジェント検出のチャンネル間リンク（リンク時は定位が動かない）
+  params.push_back(std::make_unique<juce::AudioParameterChoice>(
+      juce::ParameterID{"envelopeLink", 1}, "Detector Link",
+      juce::StringArray{"Independent", "Linked (Max)", "Linked (Average)"},
+      0));
+
+  // バイパス（getBypassParameter でホストに公開）
+  params.push_back(std::make_unique<juce::AudioParameterBool>(
+      juce::ParameterID{"bypass", 1}, "Bypass", false));
+
   return {params.begin(), params.end()};
 }
 
@@ -94,7 +117,11 @@ const juce::String VT2BBlackProcessor::getName() const {
 bool VT2BBlackProcessor::acceptsMidi() const { return false; }
 bool VT2BBlackProcessor::producesMidi() const { return false; }
 bool VT2BBlackProcessor::isMidiEffect() const { return false; }
-double VT2BBlackProcessor::getTailLengthSeconds() const { return 0.0; }
+double VT2BBlackProcessor::getTailLengthSeconds() const {
+  // エンベロープの減衰（アイドルに入るまで）を含める。ホストが無音で処理を
+  // 止めても、再開時に減衰しきっていないエンベロープが残らないように
+  return engines[activeEngine.load()].getTailLengthSeconds();
+}
 
 int VT2BBlackProcessor::getNumPrograms() { return 1; }
 int VT2BBlackProcessor::getCurrentProgram() { return 0; }
@@ -104,28 +131,51 @@ void VT2BBlackProcessor::changeProgramName(int, const juce::String &) {}
 
 //==============================================================================
 void VT2BBlackProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
-  currentSampleRate = sampleRate;
+  const juce::ScopedLock lock(engineLock);
+
+  // 処理は止まっているので、切り替え途中なら待機側を捨てる
+  standbyReady.store(false);
+  settingsFadePosition = 0;
+  settingsFadeLength = juce::jmax(
+      1, (int)std::lround(VT2BConstants::kSettingsFadeSeconds * sampleRate));
+
+  // エンジン準備（スムージング設定・状態リセット）。ここで読んだ設定より
+  // 後の変更だけがタイマーで拾われるよう、フラグを先に下ろす
+  settingsChanged.store(false);
+  preparedSettings = getAliasReductionSettings();
+
+  auto &engine = engines[activeEngine.load()];
+  applyAliasReductionSettings(engine, preparedSettings);
+  applyBlockParameters(engine, false);
+  engine.prepare(sampleRate, samplesPerBlock, getTotalNumInputChannels());
+
+  // オーバーサンプリングフィルタ / ADAA 分のレイテンシをホストに報告
+  setLatencySamples(engine.getLatencyInSamples());
+
+  const int numChannels = juce::jmax(1, getTotalNumInputChannels());
+  fadeBuffer.setSize(numChannels, juce::jmax(1, samplesPerBlock));
+  fadeBufferDouble.setSize(numChannels, juce::jmax(1, samplesPerBlock));
 
-  // スムージング設定（ジッパーノイズ防止）
-  smoothedDrive.reset(sampleRate, 0.02); // 20ms
-  smoothedMix.reset(sampleRate, 0.02);
+  telemetry.prepare(sampleRate);
+  analyzer.prepare(sampleRate, getChannelLayoutOfBus(false, 0));
 
-  // 状態リセット
-  envelopeL = 0.0f;
-  envelopeR = 0.0f;
-  allpassStateL = 0.0f;
-  allpassStateR = 0.0f;
+#if VT2B_ENABLE_PROFILER
+  profiler.prepare(sampleRate, samplesPerBlock);
+#endif
 }
 
 void VT2BBlackProcessor::releaseResources() {}
 
 bool VT2BBlackProcessor::isBusesLayoutSupported(
     const BusesLayout &layouts) const {
-  if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono() &&
-      layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+  // モノ / ステレオ / サラウンド / イマーシブ（9.1.6 まで）の任意のレイアウト。
+  // チャンネル間の処理はないので、入出力が同じならチャンネルの並びは問わない
+  const auto &output = layouts.getMainOutputChannelSet();
+
+  if (output.isDisabled() || output.size() > VT2BGlueEngine::kMaxChannels)
     return false;
 
-  if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+  if (output != layouts.getMainInputChannelSet())
     return false;
 
   return true;
@@ -134,180 +184,235 @@ bool VT2BBlackProcessor::isBusesLayoutSupported(
 //==============================================================================
 void VT2BBlackProcessor::processBlock(juce::AudioBuffer<float> &buffer,
                                       juce::MidiBuffer &midiMessages) {
-  juce::ScopedNoDenormals noDenormals;
   juce::ignoreUnused(midiMessages);
+  processSamples(buffer, false);
+}
+
+void VT2BBlackProcessor::processBlock(juce::AudioBuffer<double> &buffer,
+                                      juce::MidiBuffer &midiMessages) {
+  juce::ignoreUnused(midiMessages);
+  processSamples(buffer, false);
+}
+
+void VT2BBlackProcessor::processBlockBypassed(juce::AudioBuffer<float> &buffer,
+                                              juce::MidiBuffer &midiMessages) {
+  juce::ignoreUnused(midiMessages);
+  processSamples(buffer, true);
+}
+
+void VT2BBlackProcessor::processBlockBypassed(
+    juce::AudioBuffer<double> &buffer, juce::MidiBuffer &midiMessages) {
+  juce::ignoreUnused(midiMessages);
+  processSamples(buffer, true);
+}
+
+juce::AudioProcessorParameter *VT2BBlackProcessor::getBypassParameter() const {
+  return parameters.getParameter("bypass");
+}
+
+template <typename SampleType>
+void VT2BBlackProcessor::processSamples(juce::AudioBuffer<SampleType> &buffer,
+                                        bool hostBypassed) {
+  // 検査ビルドではこの区間の確保・ロック・ブロックする呼び出しを違反にする
+  VT2B_REALTIME_SCOPE();
+
+#if VT2B_ENABLE_PROFILER
+  const auto measurement = profiler.measure(buffer.getNumSamples());
+#endif
+
+  VT2B_TRACE_THREAD_NAME("audio");
+  VT2B_TRACE_SCOPE("audio", "processBlock");
+
+  juce::ScopedNoDenormals noDenormals;
 
   auto totalNumInputChannels = getTotalNumInputChannels();
   auto totalNumOutputChannels = getTotalNumOutputChannels();
 
-  // 未使用チャンネルをクリア
+  // 未使用チャンネルをクリア（入出力同数のレイアウトしか受けないので通常は空）
   for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
     buffer.clear(i, 0, buffer.getNumSamples());
 
-  // パラメータ取得
-  float drive = *driveParameter;
-  float mix = *mixParameter / 100.0f; // 0-1に正規化
-
-  smoothedDrive.setTargetValue(drive);
-  smoothedMix.setTargetValue(mix);
+  // 設定の切り替え中は待機側も同じパラメータで回す
+  const bool switching = standbyReady.load(std::memory_order_acquire);
+  const int active = activeEngine.load(std::memory_order_relaxed);
+  auto &engine = engines[active];
+  applyBlockParameters(engine, hostBypassed);
 
-  // サンプル処理
-  auto *channelDataL = buffer.getWritePointer(0);
-  auto *channelDataR =
-      totalNumInputChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+  if (switching)
+    applyBlockParameters(engines[1 - active], hostBypassed);
 
-  for (int sample = 0; sample < buffer.getNumSamples(); ++sample) {
-    float currentDrive = smoothedDrive.getNextValue();
-    float currentMix = smoothedMix.getNextValue();
+  // メーター（エディターが閉じている間は測らない）
+  const int numChannels =
+      juce::jmin(totalNumInputChannels, buffer.getNumChannels());
+  const bool metering = telemetry.isActive();
+  engine.setGainReductionMetering(metering);
 
-    // ドライ信号保存
-    float dryL = channelDataL[sample];
-    float dryR = channelDataR ? channelDataR[sample] : dryL;
+  if (metering)
+    telemetry.measureInput(buffer.getArrayOfReadPointers(), numChannels,
+                           buffer.getNumSamples());
 
-    // 入力ブースト (Pre-Drive Gain)
-    // Drive値に応じて入力を持ち上げ、サチュレーション回路を積極的にドライブさせる
-    // Mixノブでのブレンド時に効果がはっきりわかるようにする
-    float preDriveGain = 1.0f + (currentDrive / VT2BConstants::kDriveMax) *
-                                    1.5f; // 最大+9dB程度までブースト
+  // 解析は写すだけ（K 特性・FFT は解析スレッド）
+  const bool analyzing = analyzer.isActive();
 
-    // === 左チャンネル処理 ===
-    float wetL = dryL * preDriveGain;
+  if (analyzing)
+    analyzer.capturePre(buffer.getArrayOfReadPointers(), numChannels,
+                        buffer.getNumSamples());
 
-    // 1. サチュレーション（密度増加）
-    wetL = processSaturation(wetL, currentDrive);
+  // 信号処理はエンジンに委譲
+  if (switching)
+    crossfadeToStandby(buffer, numChannels);
+  else
+    engine.process(buffer.getArrayOfWritePointers(), numChannels,
+                   buffer.getNumSamples());
+
+  if (metering) {
+    telemetry.measureOutput(buffer.getArrayOfReadPointers(), numChannels,
+                            buffer.getNumSamples());
+    telemetry.addGainReduction(engine.takeGainReduction());
+    telemetry.endBlock(buffer.getNumSamples());
+  }
 
-    // 2. 倍音生成
-    wetL += processHarmonics(dryL * preDriveGain, currentDrive);
+  if (analyzing)
+    analyzer.capturePost(buffer.getArrayOfReadPointers(), numChannels);
+}
 
-    // 3. トランジェント整形
-    wetL = processTransient(wetL, envelopeL, currentDrive);
+template <typename SampleType>
+void VT2BBlackProcessor::crossfadeToStandby(
+    juce::AudioBuffer<SampleType> &buffer, int numChannels) {
+  const int active = activeEngine.load(std::memory_order_relaxed);
+  auto &current = engines[active];
+  auto &next = engines[1 - active];
 
-    // 4. 位相安定化 (Allpass) -> 廃止
-    // 原音の位相・キャラクターを維持するため、位相シフトを行わない
-    // wetL = processAllpass(wetL, allpassStateL);
+  auto &fade = getFadeBuffer((SampleType *)nullptr);
+  numChannels = juce::jmin(numChannels, fade.getNumChannels(),
+                           VT2BGlueEngine::kMaxChannels);
 
-    // 5. ゲイン補償
-    wetL *= calculateMakeupGain(currentDrive);
+  SampleType *outputs[VT2BGlueEngine::kMaxChannels] = {};
+  SampleType *nextOutputs[VT2BGlueEngine::kMaxChannels] = {};
+  const int numSamples = buffer.getNumSamples();
 
-    // === 右チャンネル処理 ===
-    float wetR = dryR;
+  // 待機側の出力はブロック長までしか持てないので、長いブロックは分けて回す
+  for (int start = 0, length = 0; start < numSamples; start += length) {
+    length = juce::jmin(numSamples - start, fade.getNumSamples());
 
-    if (channelDataR != nullptr) {
-      wetR = dryR * preDriveGain;
+    for (int channel = 0; channel < numChannels; ++channel)
+      outputs[channel] = buffer.getWritePointer(channel, start);
 
-      wetR = processSaturation(wetR, currentDrive);
-      wetR += processHarmonics(dryR * preDriveGain, currentDrive);
-      wetR = processTransient(wetR, envelopeR, currentDrive);
-      // wetR = processAllpass(wetR, allpassStateR);
-      wetR *= calculateMakeupGain(currentDrive);
-    } else {
-      wetR = wetL;
+    // クロスフェードが終わっていれば残りは新しい設定だけで処理する
+    if (settingsFadePosition >= settingsFadeLength) {
+      next.process(outputs, numChannels, numSamples - start);
+      break;
     }
 
-    // Dry/Wet ミックス
-    // 原音(Dry)に対してDrive効果(Wet)を加えるイメージ
-    // 位相ズレがないため、綺麗にブレンドされる
-    channelDataL[sample] = dryL * (1.0f - currentMix) + wetL * currentMix;
+    for (int channel = 0; channel < numChannels; ++channel) {
+      nextOutputs[channel] = fade.getWritePointer(channel);
+      std::copy(outputs[channel], outputs[channel] + length,
+                nextOutputs[channel]);
+    }
 
-    if (channelDataR != nullptr)
-      channelDataR[sample] = dryR * (1.0f - currentMix) + wetR * currentMix;
-  }
-}
+    current.process(outputs, numChannels, length);
+    next.process(nextOutputs, numChannels, length);
 
-//==============================================================================
-// DSP処理関数実装
+    // 2 つの出力は相関が高いので線形に混ぜる（等電力にすると中央が膨らむ）
+    for (int channel = 0; channel < numChannels; ++channel)
+      for (int i = 0; i < length; ++i) {
+        const auto gain = (SampleType)juce::jmin(
+            1.0, (double)(settingsFadePosition + i + 1) / settingsFadeLength);
+        outputs[channel][i] += (nextOutputs[channel][i] - outputs[channel][i]) *
+                               gain;
+      }
 
-float VT2BBlackProcessor::processSaturation(float input, float drive) {
-  // 密度増加型飽和特性: f(x) = x / (1 + k * |x|^n)
-  // テープ系の柔らかい非線形
-
-  float normalizedDrive = drive / VT2BConstants::kDriveMax;
-  float k = VT2BConstants::kSaturationCoeffMin +
-            normalizedDrive * (VT2BConstants::kSaturationCoeffMax -
-                               VT2BConstants::kSaturationCoeffMin);
+    settingsFadePosition += length;
+  }
 
-  float absInput = std::abs(input);
-  float saturation = std::pow(absInput, VT2BConstants::kSaturationCurve);
+  if (settingsFadePosition < settingsFadeLength)
+    return;
 
-  return input / (1.0f + k * saturation);
+  // 切り替え完了（以降は古い側がメッセージスレッドの待機側になる）
+  settingsFadePosition = 0;
+  activeEngine.store(1 - active, std::memory_order_relaxed);
+  standbyReady.store(false, std::memory_order_release);
 }
 
-float VT2BBlackProcessor::processHarmonics(float input, float drive) {
-  // 低次倍音の微量付加
-  // 2次倍音（偶数）= 暖かさ、3次倍音（奇数）= 存在感
-
-  float normalizedDrive = drive / VT2BConstants::kDriveMax;
-
-  // 倍音量はDriveに比例（ただし控えめ）
-  float harmonic2 =
-      input * input * VT2BConstants::kHarmonic2ndAmount * normalizedDrive;
-  float harmonic3 = input * input * input * VT2BConstants::kHarmonic3rdAmount *
-                    normalizedDrive;
+//==============================================================================
+bool VT2BBlackProcessor::AliasReductionSettings::operator==(
+    const AliasReductionSettings &other) const {
+  // オーバーサンプリングなしではフィルタの種類は効かない
+  return factorLog2 == other.factorLog2 &&
+         antialiasing == other.antialiasing &&
+         (factorLog2 == 0 || filter == other.filter);
+}
 
-  // 偶数倍音は常に正、奇数倍音は符号を保持
-  harmonic2 = (input >= 0.0f) ? harmonic2 : -harmonic2;
+VT2BBlackProcessor::AliasReductionSettings
+VT2BBlackProcessor::getAliasReductionSettings() const {
+  AliasReductionSettings settings;
+  settings.factorLog2 = (int)oversamplingParameter->load();
+  settings.filter = (int)oversamplingFilterParameter->load() == 0
+                        ? VT2BOversamplingFilter::MinimumPhase
+                        : VT2BOversamplingFilter::LinearPhase;
+
+  const int antialiasing = (int)antialiasingParameter->load();
+  settings.antialiasing = antialiasing == 1   ? VT2BAntialiasing::ADAA1
+                          : antialiasing == 2 ? VT2BAntialiasing::ADAA2
+                                              : VT2BAntialiasing::Off;
+  return settings;
+}
 
-  return harmonic2 + harmonic3;
+void VT2BBlackProcessor::applyAliasReductionSettings(
+    VT2BGlueEngine &target, const AliasReductionSettings &settings) {
+  target.setOversampling(settings.factorLog2, settings.filter);
+  target.setAntialiasing(settings.antialiasing);
 }
 
-float VT2BBlackProcessor::processTransient(float input, float &envelope,
-                                           float drive) {
-  // エンベロープフォロワー
-  float absInput = std::abs(input);
+void VT2BBlackProcessor::applyBlockParameters(VT2BGlueEngine &target,
+                                              bool hostBypassed) {
+  // パラメータ取得（数サンプルのブロックでも毎回呼ばれるので順序付けなしで読む。
+  // エンジン側は値が変わらなければ何もしない）
+  constexpr auto relaxed = std::memory_order_relaxed;
+  target.setDrive(driveParameter->load(relaxed));
+  target.setMix(mixParameter->load(relaxed) / 100.0f); // 0-1に正規化
+  target.setEnvelopeLink(
+      (VT2BEnvelopeLink)(int)envelopeLinkParameter->load(relaxed));
+
+  // バイパス中もエンジンに通す（レイテンシを揃えた Dry とクロスフェード）
+  target.setBypassed(hostBypassed || bypassParameter->load(relaxed) >= 0.5f);
+}
 
-  float attackCoeff = 1.0f - std::exp(-1.0f / (float(currentSampleRate) *
-                                               VT2BConstants::kEnvelopeAttack));
-  float releaseCoeff =
-      1.0f - std::exp(-1.0f / (float(currentSampleRate) *
-                               VT2BConstants::kEnvelopeRelease));
+void VT2BBlackProcessor::parameterChanged(const juce::String &, float) {
+  // オーディオスレッドから呼ばれることがあるので、フラグを立てるだけにする
+  settingsChanged.store(true);
+}
 
-  if (absInput > envelope)
-    envelope = envelope + attackCoeff * (absInput - envelope);
-  else
-    envelope = envelope + releaseCoeff * (absInput - envelope);
-
-  // トランジェント抑制量計算
-  float normalizedDrive = drive / VT2BConstants::kDriveMax;
-  float amount = VT2BConstants::kTransientAmountMin +
-                 normalizedDrive * (VT2BConstants::kTransientAmountMax -
-                                    VT2BConstants::kTransientAmountMin);
-
-  // ソフトニー適用
-  float threshold = VT2BConstants::kTransientThreshold;
-  float knee = VT2BConstants::kTransientKnee;
-
-  float reduction = 0.0f;
-  if (envelope > threshold) {
-    float excess = (envelope - threshold) / knee;
-    reduction = std::min(1.0f, excess) * amount;
-  }
+void VT2BBlackProcessor::timerCallback() {
+  // 切り替え中は待機側がオーディオスレッドのものなので、次の周期に回す
+  if (standbyReady.load(std::memory_order_acquire) ||
+      !settingsChanged.exchange(false))
+    return;
 
-  return input * (1.0f - reduction);
-}
+  const juce::ScopedLock lock(engineLock);
 
-// 保持（ヘッダーで宣言されているため定義必須、ただし未使用）
-float VT2BBlackProcessor::processAllpass(float input, float &state) {
-  // 1次オールパスフィルタ（位相安定化）
-  // 低域の位相を安定させ、ステレオ像を維持
+  // 未準備ならパラメータは次の prepareToPlay で反映される
+  if (getSampleRate() <= 0.0 || getBlockSize() <= 0)
+    return;
 
-  float omega = 2.0f * juce::MathConstants<float>::pi *
-                VT2BConstants::kAllpassFrequency / float(currentSampleRate);
-  float coeff =
-      (1.0f - std::tan(omega / 2.0f)) / (1.0f + std::tan(omega / 2.0f));
+  // 効果が同じ設定（1x でのフィルタの切り替えなど）なら作り直さない
+  const auto settings = getAliasReductionSettings();
 
-  float output = coeff * (input - state) + state;
-  state = coeff * (output - input) + input;
+  if (settings == preparedSettings)
+    return;
 
-  // 元信号との50%ブレンド
-  return input * 0.5f + output * 0.5f;
-}
+  // 待機側をいまのパラメータで準備する（使用中のエンジンは止めずに回り続ける）
+  auto &standby = engines[1 - activeEngine.load()];
+  applyAliasReductionSettings(standby, settings);
+  applyBlockParameters(standby, false);
+  standby.prepare(getSampleRate(), getBlockSize(), getTotalNumInputChannels());
+  preparedSettings = settings;
 
-float VT2BBlackProcessor::calculateMakeupGain(float drive) {
-  // Driveによる音量変化（入力ブースト + サチュレーション）を相殺
-  float normalizedDrive = drive / VT2BConstants::kDriveMax;
+  // レイテンシが変わるときだけホストに報告し直す
+  if (standby.getLatencyInSamples() != getLatencySamples())
+    setLatencySamples(standby.getLatencyInSamples());
 
-  // ブースト分を抑えつつ、サチュレーションでの圧縮感を残すバランス
-  return 1.0f / (1.0f + normalizedDrive * 0.8f);
+  standbyReady.store(true, std::memory_order_release);
 }
 
 //==============================================================================
@@ -319,6 +424,7 @@ juce::AudioProcessorEditor *VT2BBlackProcessor::createEditor() {
 
 //==============================================================================
 void VT2BBlackProcessor::getStateInformation(juce::MemoryBlock &destData) {
+  VT2B_TRACE_SCOPE("state", "getStateInformation");
   auto state = parameters.copyState();
   std::unique_ptr<juce::XmlElement> xml(state.createXml());
   copyXmlToBinary(*xml, destData);
@@ -326,6 +432,7 @@ void VT2BBlackProcessor::getStateInformation(juce::MemoryBlock &destData) {
 
 void VT2BBlackProcessor::setStateInformation(const void *data,
                                              int sizeInBytes) {
+  VT2B_TRACE_SCOPE("state", "setStateInformation");
   std::unique_ptr<juce::XmlElement> xmlState(
       getXmlFromBinary(data, sizeInBytes));
 
@@ -12,6 +12,12 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_audio_utils/juce_audio_utils.h>
 
+#include "VT2BAnalyzer.h"
+#include "dsp/VT2BBlockProfiler.h"
+#include "dsp/VT2BGlueEngine.h"
+#include "dsp/VT2BTelemetry.h"
+#include "dsp/VT2BTrace.h"
+
 //==============================================================================
 /**
  * VT-2B Black Processor
@@ -19,7 +25,10 @@
  * コンソールサミング/バス回路を意識した密度増加型サチュレーション。
  * 派手さを抑え、音をまとめる方向に作用する。
  */
-class VT2BBlackProcessor : public juce::AudioProcessor {
+class VT2BBlackProcessor
+    : public juce::AudioProcessor,
+      private juce::AudioProcessorValueTreeState::Listener,
+      private juce::Timer {
 public:
   //==============================================================================
   VT2BBlackProcessor();
@@ -32,6 +41,17 @@ public:
   bool isBusesLayoutSupported(const BusesLayout &layouts) const override;
 
   void processBlock(juce::AudioBuffer<float> &, juce::MidiBuffer &) override;
+  void processBlock(juce::AudioBuffer<double> &, juce::MidiBuffer &) override;
+
+  // 倍精度ホストでは Dry 経路を double のまま保つ（Wet 系は float で処理）
+  bool supportsDoublePrecisionProcessing() const override { return true; }
+
+  // ホストのバイパス（DSP は回さず、切り替えはクロスフェード）
+  void processBlockBypassed(juce::AudioBuffer<float> &,
+                            juce::MidiBuffer &) override;
+  void processBlockBypassed(juce::AudioBuffer<double> &,
+                            juce::MidiBuffer &) override;
+  juce::AudioProcessorParameter *getBypassParameter() const override;
 
   //==============================================================================
   juce::AudioProcessorEditor *createEditor() override;
@@ -60,66 +80,111 @@ public:
   // パラメータアクセス
   juce::AudioProcessorValueTreeState &getParameters() { return parameters; }
 
+  // メーター値（エディターが開いている間だけ積まれる）
+  VT2BMeterTelemetry &getTelemetry() { return telemetry; }
+
+  // ラウドネス・スペクトル（エディターが解析表示を開いている間だけ動く）
+  VT2BAnalyzer &getAnalyzer() { return analyzer; }
+
+  // NaN / Inf の入力・状態から復帰した回数（診断用、どのスレッドからでも）
+  uint64_t getNumNonFiniteEvents() const {
+    return engines[0].getNumNonFiniteEvents() +
+           engines[1].getNumNonFiniteEvents();
+  }
+
+#if VT2B_ENABLE_PROFILER
+  // ブロックごとの処理時間（エディターから読む・ファイルに書く）
+  VT2BBlockProfiler &getProfiler() { return profiler; }
+#endif
+
 private:
+  //==============================================================================
+  template <typename SampleType>
+  void processSamples(juce::AudioBuffer<SampleType> &buffer,
+                      bool hostBypassed);
+
+  /** 使用中のエンジンと待機側のエンジンを並べて処理し、待機側へ切り替える */
+  template <typename SampleType>
+  void crossfadeToStandby(juce::AudioBuffer<SampleType> &buffer,
+                          int numChannels);
+
+  juce::AudioBuffer<float> &getFadeBuffer(float *) { return fadeBuffer; }
+  juce::AudioBuffer<double> &getFadeBuffer(double *) {
+    return fadeBufferDouble;
+  }
+
   //==============================================================================
   // パラメータ
   juce::AudioProcessorValueTreeState parameters;
 
   std::atomic<float> *driveParameter = nullptr;
   std::atomic<float> *mixParameter = nullptr;
+  std::atomic<float> *oversamplingParameter = nullptr;
+  std::atomic<float> *oversamplingFilterParameter = nullptr;
+  std::atomic<float> *antialiasingParameter = nullptr;
+  std::atomic<float> *envelopeLinkParameter = nullptr;
+  std::atomic<float> *bypassParameter = nullptr;
 
   //==============================================================================
-  // DSP状態
-  double currentSampleRate = 44100.0;
+  // DSPエンジン（信号処理本体）
+  // オーバーサンプリング / ADAA の設定を変えるときは、メッセージスレッドで
+  // 待機側を準備し、オーディオスレッドがクロスフェードで切り替える
+  VT2BGlueEngine engines[2];
+  std::atomic<int> activeEngine{0};
 
-  // エンベロープフォロワー（トランジェント検出用）
-  float envelopeL = 0.0f;
-  float envelopeR = 0.0f;
+  // true の間、待機側のエンジンはオーディオスレッドのもの（切り替え中）
+  std::atomic<bool> standbyReady{false};
+  int settingsFadePosition = 0; // オーディオスレッドのみ
+  int settingsFadeLength = 1;
 
-  // オールパスフィルタ状態
-  float allpassStateL = 0.0f;
-  float allpassStateR = 0.0f;
+  // 待機側の出力（prepareToPlay でブロック長分確保する）
+  juce::AudioBuffer<float> fadeBuffer;
+  juce::AudioBuffer<double> fadeBufferDouble;
 
-  // スムージング
-  juce::SmoothedValue<float> smoothedDrive;
-  juce::SmoothedValue<float> smoothedMix;
+  // prepareToPlay と待機側の準備を排他にする（どちらもオーディオスレッド外）
+  juce::CriticalSection engineLock;
 
-  //==============================================================================
-  // DSP処理関数
-
-  /**
-   * 密度増加型サチュレーション
-   * テープ系の柔らかい飽和特性をモデリング
-   */
-  float processSaturation(float input, float drive);
-
-  /**
-   * 低次倍音生成（2次/3次）
-   * 暖かさと存在感を微量付加
-   */
-  float processHarmonics(float input, float drive);
-
-  /**
-   * トランジェント整形
-   * ピークの暴れを抑えつつパンチは残す
-   */
-  float processTransient(float input, float &envelope, float drive);
-
-  /**
-   * 位相安定化オールパス
-   * 低域の位相を安定させステレオ像を維持
-   */
-  float processAllpass(float input, float &state);
-
-  /**
-   * 自動ゲイン補償
-   * Drive増加による音量変化を相殺
-   */
-  float calculateMakeupGain(float drive);
+  // オーディオスレッド → エディターのメーター値
+  VT2BMeterTelemetry telemetry;
+
+  // 処理前後のサンプルを解析スレッドへ
+  VT2BAnalyzer analyzer;
+
+#if VT2B_ENABLE_PROFILER
+  VT2BBlockProfiler profiler;
+#endif
 
   //==============================================================================
   // パラメータレイアウト作成
   juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+  //==============================================================================
+  // オーバーサンプリング / ADAA の設定（効果が同じなら切り替えない）
+  struct AliasReductionSettings {
+    int factorLog2 = 0;
+    VT2BOversamplingFilter filter = VT2BOversamplingFilter::MinimumPhase;
+    VT2BAntialiasing antialiasing = VT2BAntialiasing::Off;
+
+    bool operator==(const AliasReductionSettings &other) const;
+  };
+
+  AliasReductionSettings getAliasReductionSettings() const;
+  AliasReductionSettings preparedSettings; // engineLock で守る
+
+  /** 設定をエンジンに渡す（prepare 前に呼ぶ） */
+  void applyAliasReductionSettings(VT2BGlueEngine &target,
+                                   const AliasReductionSettings &settings);
+
+  /** ブロックごとのパラメータをエンジンに渡す */
+  void applyBlockParameters(VT2BGlueEngine &target, bool hostBypassed);
+
+  // 設定の変更はフラグを立てるだけ（オーディオスレッドから呼ばれることがある）。
+  // メッセージスレッドのタイマーが拾って待機側のエンジンを準備する
+  void parameterChanged(const juce::String &parameterID,
+                        float newValue) override;
+  void timerCallback() override;
+
+  std::atomic<bool> settingsChanged{false};
+
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VT2BBlackProcessor)
 };
@@ -0,0 +1,416 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Loudness / Spectrum Analyzer Implementation
+  ==============================================================================
+*/
+
+#include "VT2BAnalyzer.h"
+
+#include <cmath>
+
+namespace {
+// BS.1770: ブロックのラウドネス = -0.691 + 10 log10(重み付き平均二乗)
+constexpr double kLoudnessOffset = -0.691;
+constexpr double kAbsoluteGateLufs = -70.0;
+constexpr double kRelativeGateLu = -10.0;
+
+constexpr int kSubBlocksPerMomentary = 4;  // 400 ms
+constexpr int kSubBlocksPerShortTerm = 30; // 3 s
+
+constexpr float kSpectrumSmoothing = 0.7f; // 前回のパワーの割合
+constexpr float kLowestBandHz = 20.0f;
+constexpr float kHighestBandHz = 20000.0f;
+
+float toLufs(double meanSquare) {
+  if (!(meanSquare > 0.0))
+    return VT2BAnalysisResults::kFloorDb;
+
+  return juce::jmax(VT2BAnalysisResults::kFloorDb,
+                    (float)(kLoudnessOffset + 10.0 * std::log10(meanSquare)));
+}
+
+double fromLufs(double lufs) {
+  return std::pow(10.0, (lufs - kLoudnessOffset) / 10.0);
+}
+
+/** BS.1770 のチャンネル重み（LFE は除外、後方のサラウンドは +1.5 dB） */
+float getLoudnessWeight(juce::AudioChannelSet::ChannelType type) {
+  using Set = juce::AudioChannelSet;
+
+  switch (type) {
+  case Set::LFE:
+  case Set::LFE2:
+    return 0.0f;
+  case Set::leftSurround:
+  case Set::rightSurround:
+  case Set::leftSurroundSide:
+  case Set::rightSurroundSide:
+  case Set::leftSurroundRear:
+  case Set::rightSurroundRear:
+    return 1.41f;
+  default:
+    return 1.0f;
+  }
+}
+} // namespace
+
+//==============================================================================
+VT2BAnalyzer::VT2BAnalyzer() : juce::Thread("VT-2B Analyzer") {}
+
+VT2BAnalyzer::~VT2BAnalyzer() { setActive(false); }
+
+void VT2BAnalyzer::prepare(double sampleRate,
+                           const juce::AudioChannelSet &channels) {
+  // 解析スレッドを止めてから作り直す。その間にエディターが setActive() を
+  // 呼んでも、作り直しが終わるまで待たせる
+  const juce::ScopedLock lock(activeLock);
+  const bool wasActive = isActive();
+  setActive(false);
+
+  currentSampleRate = sampleRate;
+
+  const int numChannels = juce::jmax(1, channels.size());
+  ring.prepare(kFirstPostLane + numChannels);
+
+  channelWeights.resize((size_t)numChannels);
+  for (int channel = 0; channel < numChannels; ++channel)
+    channelWeights[(size_t)channel] =
+        channels.size() > 0
+            ? getLoudnessWeight(channels.getTypeOfChannel(channel))
+            : 1.0f;
+
+  filterStates.assign((size_t)numChannels, {});
+  postScratch.assign((size_t)numChannels * kChunkSize, 0.0f);
+  preScratch.assign(kChunkSize, 0.0f);
+
+  // K 特性（BS.1770-4 の 48 kHz の係数を任意のレートで再設計したもの）
+  {
+    const double f0 = 1681.974450955533;
+    const double gainDb = 3.999843853973347;
+    const double q = 0.7071752369554196;
+
+    const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+    const double vh = std::pow(10.0, gainDb / 20.0);
+    const double vb = std::pow(vh, 0.4996667741545416);
+    const double a0 = 1.0 + k / q + k * k;
+
+    shelf.b0 = (vh + vb * k / q + k * k) / a0;
+    shelf.b1 = 2.0 * (k * k - vh) / a0;
+    shelf.b2 = (vh - vb * k / q + k * k) / a0;
+    shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+    shelf.a2 = (1.0 - k / q + k * k) / a0;
+  }
+  {
+    const double f0 = 38.13547087602444;
+    const double q = 0.5003270373238773;
+
+    const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+    const double a0 = 1.0 + k / q + k * k;
+
+    highPass.b0 = 1.0;
+    highPass.b1 = -2.0;
+    highPass.b2 = 1.0;
+    highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+    highPass.a2 = (1.0 - k / q + k * k) / a0;
+  }
+
+  subBlockLength = juce::jmax(1, juce::roundToInt(sampleRate * 0.1));
+  recentSubBlocks.assign(kSubBlocksPerShortTerm, 0.0);
+
+  // スペクトル
+  window.assign(kFftSize, 0.0f);
+  juce::dsp::WindowingFunction<float>::fillWindowingTables(
+      window.data(), kFftSize, juce::dsp::WindowingFunction<float>::hann,
+      false);
+
+  fftBuffer.assign(2 * kFftSize, 0.0f);
+  preHistory.assign(kFftSize, 0.0f);
+  postHistory.assign(kFftSize, 0.0f);
+
+  const float binWidth = (float)(sampleRate / kFftSize);
+  const float highestBand =
+      juce::jmin(kHighestBandHz, (float)sampleRate * 0.5f);
+
+  for (int band = 0; band <= VT2BAnalysisResults::kNumBands; ++band) {
+    const float frequency =
+        kLowestBandHz *
+        std::pow(highestBand / kLowestBandHz,
+                 (float)band / VT2BAnalysisResults::kNumBands);
+    bandEdges[(size_t)band] =
+        juce::jlimit(1, kFftSize / 2, juce::roundToInt(frequency / binWidth));
+  }
+
+  resetAnalysis();
+
+  if (wasActive)
+    setActive(true);
+}
+
+void VT2BAnalyzer::setActive(bool shouldBeActive) {
+  const juce::ScopedLock lock(activeLock);
+
+  if (shouldBeActive == isActive())
+    return;
+
+  if (shouldBeActive) {
+    // 止めていた間の分は使わない（オーディオスレッドはまだ書いていない）
+    ring.discardAll();
+    resetAnalysis();
+    startThread(juce::Thread::Priority::low);
+    active.store(true);
+  } else {
+    active.store(false);
+    stopThread(1000);
+  }
+}
+
+bool VT2BAnalyzer::getLatestResults(VT2BAnalysisResults &destination) {
+  bool hasResults = false;
+
+  while (results.pop(destination))
+    hasResults = true;
+
+  return hasResults;
+}
+
+//==============================================================================
+void VT2BAnalyzer::run() {
+  const int numChannels = (int)channelWeights.size();
+
+  while (!threadShouldExit()) {
+    if (resetRequested.exchange(false))
+      resetLoudnessState();
+
+    bool processed = false;
+
+    for (int ready = ring.getNumReady(); ready > 0 && !threadShouldExit();
+         ready = ring.getNumReady()) {
+      const int numSamples = juce::jmin(ready, kChunkSize);
+
+      ring.read(kPreLane, preScratch.data(), numSamples);
+
+      for (int channel = 0; channel < numChannels; ++channel)
+        ring.read(kFirstPostLane + channel,
+                  postScratch.data() + (size_t)channel * kChunkSize,
+                  numSamples);
+
+      ring.consume(numSamples);
+
+      processLoudness(numSamples);
+      processSpectrum(numSamples);
+      processed = true;
+    }
+
+    if (processed)
+      publish();
+
+    wait(15);
+  }
+}
+
+void VT2BAnalyzer::resetAnalysis() {
+  resetLoudnessState();
+
+  std::fill(preHistory.begin(), preHistory.end(), 0.0f);
+  std::fill(postHistory.begin(), postHistory.end(), 0.0f);
+  historyPosition = 0;
+  samplesSinceFft = 0;
+  prePower.fill(0.0f);
+  postPower.fill(0.0f);
+}
+
+void VT2BAnalyzer::resetLoudnessState() {
+  for (auto &state : filterStates)
+    state.fill(0.0);
+
+  subBlockPosition = 0;
+  subBlockEnergy = 0.0;
+  std::fill(recentSubBlocks.begin(), recentSubBlocks.end(), 0.0);
+  recentPosition = 0;
+  numRecent = 0;
+  gatingEnergy.fill(0.0);
+  gatingCounts.fill(0);
+  gatedEnergy = 0.0;
+  numGated = 0;
+
+  latest.momentaryLufs = VT2BAnalysisResults::kFloorDb;
+  latest.shortTermLufs = VT2BAnalysisResults::kFloorDb;
+  latest.integratedLufs = VT2BAnalysisResults::kFloorDb;
+}
+
+//==============================================================================
+void VT2BAnalyzer::processLoudness(int numSamples) {
+  const int numChannels = (int)channelWeights.size();
+
+  for (int start = 0, length = 0; start < numSamples; start += length) {
+    length = juce::jmin(numSamples - start, subBlockLength - subBlockPosition);
+
+    // K 特性を通した二乗和（100 ms のサブブロックごと）
+    for (int channel = 0; channel < numChannels; ++channel) {
+      const float weight = channelWeights[(size_t)channel];
+
+      if (weight == 0.0f)
+        continue;
+
+      const float *input =
+          postScratch.data() + (size_t)channel * kChunkSize + start;
+      auto &state = filterStates[(size_t)channel];
+      double sum = 0.0;
+
+      for (int i = 0; i < length; ++i) {
+        const double x = input[i];
+        const double y = shelf.b0 * x + state[0];
+        state[0] = shelf.b1 * x - shelf.a1 * y + state[1];
+        state[1] = shelf.b2 * x - shelf.a2 * y;
+
+        const double z = highPass.b0 * y + state[2];
+        state[2] = highPass.b1 * y - highPass.a1 * z + state[3];
+        state[3] = highPass.b2 * y - highPass.a2 * z;
+
+        sum += z * z;
+      }
+
+      subBlockEnergy += weight * sum;
+    }
+
+    subBlockPosition += length;
+
+    if (subBlockPosition < subBlockLength)
+      continue;
+
+    recentSubBlocks[(size_t)recentPosition] = subBlockEnergy / subBlockLength;
+    recentPosition = (recentPosition + 1) % kSubBlocksPerShortTerm;
+    numRecent = juce::jmin(numRecent + 1, kSubBlocksPerShortTerm);
+    subBlockPosition = 0;
+    subBlockEnergy = 0.0;
+
+    // 直近 n 個のサブブロックの平均（溜まっていなければある分だけ）
+    auto getRecentMean = [this](int count) {
+      count = juce::jmin(count, numRecent);
+      double sum = 0.0;
+
+      for (int i = 1; i <= count; ++i)
+        sum += recentSubBlocks[(size_t)((recentPosition - i +
+                                         kSubBlocksPerShortTerm) %
+                                        kSubBlocksPerShortTerm)];
+
+      return sum / count;
+    };
+
+    const double momentary = getRecentMean(kSubBlocksPerMomentary);
+    latest.momentaryLufs = toLufs(momentary);
+    latest.shortTermLufs = toLufs(getRecentMean(kSubBlocksPerShortTerm));
+
+    if (numRecent < kSubBlocksPerMomentary)
+      continue;
+
+    // ゲーティング（400 ms ブロック、100 ms ずつずらす）。絶対ゲートを
+    // 超えたブロックだけをラウドネスのビンに積む（全ブロックは持たない）
+    if (momentary > fromLufs(kAbsoluteGateLufs)) {
+      const double lufs = kLoudnessOffset + 10.0 * std::log10(momentary);
+      const int bin = juce::jlimit(
+          0, kNumGatingBins - 1,
+          (int)std::floor((lufs - kAbsoluteGateLufs) / kGatingBinLu));
+
+      gatingEnergy[(size_t)bin] += momentary;
+      ++gatingCounts[(size_t)bin];
+      gatedEnergy += momentary;
+      ++numGated;
+    }
+
+    if (numGated == 0) {
+      latest.integratedLufs = VT2BAnalysisResults::kFloorDb;
+      continue;
+    }
+
+    // 相対ゲート以上のビン（絶対ゲートより下なら全部）の和
+    const double relativeGateLufs =
+        toLufs(gatedEnergy / numGated) + kRelativeGateLu;
+    const int firstBin = juce::jmax(
+        0, (int)std::ceil((relativeGateLufs - kAbsoluteGateLufs) /
+                          kGatingBinLu));
+    double sum = 0.0;
+    int count = 0;
+
+    for (int bin = firstBin; bin < kNumGatingBins; ++bin) {
+      sum += gatingEnergy[(size_t)bin];
+      count += gatingCounts[(size_t)bin];
+    }
+
+    latest.integratedLufs =
+        count > 0 ? toLufs(sum / count) : VT2BAnalysisResults::kFloorDb;
+  }
+}
+
+//==============================================================================
+void VT2BAnalyzer::processSpectrum(int numSamples) {
+  const int numChannels = (int)channelWeights.size();
+  const float scale = 1.0f / (float)numChannels;
+
+  for (int i = 0; i < numSamples; ++i) {
+    // 処理後はチャンネルの平均（処理前と同じモノラル）
+    float post = 0.0f;
+    for (int channel = 0; channel < numChannels; ++channel)
+      post += postScratch[(size_t)channel * kChunkSize + (size_t)i];
+
+    preHistory[(size_t)historyPosition] = preScratch[(size_t)i];
+    postHistory[(size_t)historyPosition] = post * scale;
+    historyPosition = (historyPosition + 1) & (kFftSize - 1);
+
+    if (++samplesSinceFft == kFftHop) {
+      samplesSinceFft = 0;
+      computeSpectrum(preHistory, prePower);
+      computeSpectrum(postHistory, postPower);
+    }
+  }
+}
+
+void VT2BAnalyzer::computeSpectrum(const std::vector<float> &history,
+                                   BandPowers &power) {
+  // 古い順に並べて窓をかける
+  for (int i = 0; i < kFftSize; ++i)
+    fftBuffer[(size_t)i] =
+        history[(size_t)((historyPosition + i) & (kFftSize - 1))] *
+        window[(size_t)i];
+
+  std::fill(fftBuffer.begin() + kFftSize, fftBuffer.end(), 0.0f);
+  fft.performFrequencyOnlyForwardTransform(fftBuffer.data(), true);
+
+  // フルスケールの正弦波が 0 dB になる振幅（Hann の平均は 0.5）
+  const float amplitudeScale = 4.0f / (float)kFftSize;
+
+  for (int band = 0; band < VT2BAnalysisResults::kNumBands; ++band) {
+    const int first = bandEdges[(size_t)band];
+    const int last = juce::jmax(first + 1, bandEdges[(size_t)band + 1]);
+    float peak = 0.0f;
+
+    // 帯域内の最大（低域で帯域がビンより狭いときは最寄りの 1 ビン）
+    for (int bin = first; bin < last && bin <= kFftSize / 2; ++bin)
+      peak = juce::jmax(peak, fftBuffer[(size_t)bin]);
+
+    const float amplitude = peak * amplitudeScale;
+    auto &smoothed = power[(size_t)band];
+    smoothed = smoothed * kSpectrumSmoothing +
+               amplitude * amplitude * (1.0f - kSpectrumSmoothing);
+  }
+}
+
+void VT2BAnalyzer::publish() {
+  auto toDb = [](float bandPower) {
+    return bandPower > 0.0f
+               ? juce::jmax(VT2BAnalysisResults::kFloorDb,
+                            10.0f * std::log10(bandPower))
+               : VT2BAnalysisResults::kFloorDb;
+  };
+
+  for (int band = 0; band < VT2BAnalysisResults::kNumBands; ++band) {
+    latest.preSpectrumDb[(size_t)band] = toDb(prePower[(size_t)band]);
+    latest.postSpectrumDb[(size_t)band] = toDb(postPower[(size_t)band]);
+  }
+
+  latest.droppedSamples = ring.getNumDropped();
+
+  // エディターが読まずに満杯なら捨てる（待たない）
+  results.push(latest);
+}
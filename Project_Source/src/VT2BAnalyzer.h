@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Loudness / Spectrum Analyzer
+
+    ラウドネス（ITU-R BS.1770 / EBU R128 のモーメンタリー・ショートターム・
+    インテグレーテッド）と処理前後のスペクトルを解析スレッドで求める。
+    オーディオスレッドはサンプルをリング（VT2BAnalysisRing）に写すだけ。
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+
+#include "dsp/VT2BAnalysisRing.h"
+#include "dsp/VT2BTelemetry.h"
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+/** 解析結果（解析スレッド → エディター） */
+struct VT2BAnalysisResults {
+  static constexpr int kNumBands = 96; // 20 Hz〜20 kHz の対数間隔
+  static constexpr float kFloorDb = -100.0f;
+
+  float momentaryLufs = kFloorDb;  // 400 ms
+  float shortTermLufs = kFloorDb;  // 3 s
+  float integratedLufs = kFloorDb; // ゲート付き（解析開始 / リセット以降）
+
+  std::array<float, kNumBands> preSpectrumDb{};  // 処理前（dBFS、モノラル）
+  std::array<float, kNumBands> postSpectrumDb{}; // 処理後
+
+  uint64_t droppedSamples = 0; // 解析が追いつかず捨てたサンプル数
+};
+
+//==============================================================================
+/**
+ * ラウドネス・スペクトル解析
+ *
+ * オーディオスレッドは isActive() のときだけ capturePre() / capturePost() で
+ * 処理前（モノラル）と処理後（チャンネルごと）をリングに写す。解析スレッドが
+ * K 特性フィルタ・ゲーティング・FFT を行い、結果をキューに積む。解析が
+ * 追いつかなければリングが満杯になり、オーディオスレッドはブロックごと捨てる。
+ *
+ * prepare() / setActive() はオーディオスレッド外から呼ぶ（互いに排他で、
+ * prepare() は解析スレッドを止めてから作り直す）。
+ */
+class VT2BAnalyzer : private juce::Thread {
+public:
+  VT2BAnalyzer();
+  ~VT2BAnalyzer() override;
+
+  /** サンプルレートとチャンネル配置（ラウドネスの重み）を設定する */
+  void prepare(double sampleRate, const juce::AudioChannelSet &channels);
+
+  /** 解析の開始・停止（開始時にインテグレーテッドは消える） */
+  void setActive(bool shouldBeActive);
+  bool isActive() const { return active.load(std::memory_order_relaxed); }
+
+  /** インテグレーテッドを測り直す（どのスレッドからでも） */
+  void resetLoudness() { resetRequested.store(true); }
+
+  //==============================================================================
+  // オーディオスレッド側（processBlock の処理前・処理後に 1 回ずつ）
+
+  template <typename SampleType>
+  void capturePre(const SampleType *const *channels, int numChannels,
+                  int numSamples) {
+    if (ring.beginWrite(numSamples))
+      ring.writeMono(kPreLane, channels,
+                     juce::jmin(numChannels, ring.getNumLanes() - 1));
+  }
+
+  template <typename SampleType>
+  void capturePost(const SampleType *const *channels, int numChannels) {
+    numChannels = juce::jmin(numChannels, ring.getNumLanes() - 1);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+      ring.writeLane(kFirstPostLane + channel, channels[channel]);
+
+    ring.commitWrite();
+  }
+
+  //==============================================================================
+  /** 最新の結果を取り出す（エディター側、新しい結果がなければ false） */
+  bool getLatestResults(VT2BAnalysisResults &destination);
+
+private:
+  static constexpr int kPreLane = 0;
+  static constexpr int kFirstPostLane = 1;
+  static constexpr int kFftOrder = 12; // 4096 点
+  static constexpr int kFftSize = 1 << kFftOrder;
+  static constexpr int kFftHop = kFftSize / 4;
+  static constexpr int kChunkSize = 1024;
+
+  // ゲーティングブロックのヒストグラム（絶対ゲート -70 LUFS から 0.1 LU 刻み）
+  static constexpr int kNumGatingBins = 1000;
+  static constexpr double kGatingBinLu = 0.1;
+
+  void run() override;
+
+  using BandPowers = std::array<float, VT2BAnalysisResults::kNumBands>;
+
+  /** 解析の状態を初期化する（スレッド停止中か、解析スレッド上で呼ぶ） */
+  void resetAnalysis();
+  void resetLoudnessState();
+
+  void processLoudness(int numSamples);
+  void processSpectrum(int numSamples);
+  void computeSpectrum(const std::vector<float> &history, BandPowers &power);
+  void publish();
+
+  // 2 次 IIR（K 特性の 2 段、Direct Form II transposed）
+  struct Biquad {
+    double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+  };
+
+  std::atomic<bool> active{false};
+  std::atomic<bool> resetRequested{false};
+
+  // prepare() と setActive() を排他にする（作り直しの間は止めたままにする）
+  juce::CriticalSection activeLock;
+
+  double currentSampleRate = 48000.0;
+  VT2BAnalysisRing ring;
+  VT2BSpscQueue<VT2BAnalysisResults, 8> results;
+
+  // ラウドネス（チャンネルごとの重みと K 特性フィルタの状態）
+  Biquad shelf, highPass;
+  std::vector<float> channelWeights;
+  std::vector<std::array<double, 4>> filterStates;
+  std::vector<float> postScratch; // [lane][kChunkSize]
+  std::vector<float> preScratch;
+
+  int subBlockLength = 4800; // 100 ms
+  int subBlockPosition = 0;
+  double subBlockEnergy = 0.0;
+  std::vector<double> recentSubBlocks; // 直近 3 s（30 個、リング）
+  int recentPosition = 0;
+  int numRecent = 0;
+
+  // 400 ms ブロック（75% 重なり）のうち絶対ゲートを超えたもの。相対ゲートは
+  // ビンの下端に揃え、ゲートより上のビンの和と個数だけを足す
+  std::array<double, kNumGatingBins> gatingEnergy{};
+  std::array<int, kNumGatingBins> gatingCounts{};
+  double gatedEnergy = 0.0; // 絶対ゲートを超えたブロックの和
+  int numGated = 0;
+
+  // スペクトル（処理前後の直近 kFftSize サンプル）
+  juce::dsp::FFT fft{kFftOrder};
+  std::vector<float> window;
+  std::vector<float> fftBuffer;
+  std::vector<float> preHistory, postHistory; // リング（historyPosition が最古）
+  int historyPosition = 0;
+  int samplesSinceFft = 0;
+  std::array<int, VT2BAnalysisResults::kNumBands + 1> bandEdges{}; // FFT のビン
+  BandPowers prePower{}, postPower{}; // 平滑化したパワー
+
+  VT2BAnalysisResults latest;
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VT2BAnalyzer)
+};
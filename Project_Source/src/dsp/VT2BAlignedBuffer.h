@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Aligned Scratch Buffer
+
+    SIMDロード/ストア用に64バイト境界へ揃えた作業バッファ
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//==============================================================================
+/**
+ * 64バイト（キャッシュライン / AVX-512 幅）境界に揃えたバッファ
+ *
+ * allocate() はオーディオスレッド外（prepare 時）にのみ呼ぶこと。
+ */
+template <typename SampleType> class VT2BAlignedArray {
+public:
+  static constexpr size_t kAlignment = 64;
+
+  VT2BAlignedArray() = default;
+  VT2BAlignedArray(VT2BAlignedArray &&) = default;
+  VT2BAlignedArray &operator=(VT2BAlignedArray &&) = default;
+
+  // data が storage 内を指すためコピー不可（ムーブはヒープ領域ごと移るので可）
+  VT2BAlignedArray(const VT2BAlignedArray &) = delete;
+  VT2BAlignedArray &operator=(const VT2BAlignedArray &) = delete;
+
+  void allocate(int numSamples) {
+    const size_t padding = kAlignment / sizeof(SampleType);
+    storage.assign((size_t)(numSamples > 0 ? numSamples : 0) + padding,
+                   SampleType(0));
+
+    auto address = reinterpret_cast<uintptr_t>(storage.data());
+    auto aligned = (address + kAlignment - 1) & ~(uintptr_t)(kAlignment - 1);
+    data = storage.data() + (aligned - address) / sizeof(SampleType);
+    size = numSamples;
+  }
+
+  SampleType *get() { return data; }
+  const SampleType *get() const { return data; }
+  int getSize() const { return size; }
+
+private:
+  std::vector<SampleType> storage;
+  SampleType *data = nullptr;
+  int size = 0;
+};
+
+/** float の作業バッファ（カーネル・係数列用） */
+using VT2BAlignedBuffer = VT2BAlignedArray<float>;
@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Analysis Ring
+
+    オーディオスレッドから解析スレッドへサンプル列を渡すリングバッファ。
+    複数のレーン（処理前のモノラル・処理後の各チャンネルなど）で読み書きの
+    位置を共有し、1 ブロック分をまとめて公開する。
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//==============================================================================
+/**
+ * 単一プロデューサー / 単一コンシューマーのサンプルリング
+ *
+ * プロデューサー（オーディオスレッド）は beginWrite() で空きを確かめ、
+ * レーンごとに書いてから commitWrite() で公開する。空きが足りなければ
+ * ブロックごと捨てて数えるだけで、待たない。コンシューマー（解析スレッド）は
+ * getNumReady() 分を read() で読み、consume() で解放する。
+ *
+ * prepare() は両スレッドが止まっている間に呼ぶこと。
+ */
+class VT2BAnalysisRing {
+public:
+  static constexpr int kCapacity = 1 << 15; // 2 の累乗（48 kHz で約 0.7 秒）
+
+  /** レーン数分の領域を確保し、位置を戻す */
+  void prepare(int numLanes) {
+    lanes = std::max(numLanes, 0);
+    storage.assign((size_t)lanes * kCapacity, 0.0f);
+    writeIndex.store(0, std::memory_order_relaxed);
+    readIndex.store(0, std::memory_order_relaxed);
+    droppedSamples.store(0, std::memory_order_relaxed);
+    pendingSamples = 0;
+  }
+
+  int getNumLanes() const { return lanes; }
+
+  //==============================================================================
+  // プロデューサー側
+
+  /** numSamples 分の空きがあれば書き込みを始める（なければ捨てた分を数える） */
+  bool beginWrite(int numSamples) {
+    const uint64_t write = writeIndex.load(std::memory_order_relaxed);
+    const uint64_t read = readIndex.load(std::memory_order_acquire);
+
+    if (numSamples <= 0 || lanes == 0 ||
+        write - read + (uint64_t)numSamples > (uint64_t)kCapacity) {
+      droppedSamples.store(droppedSamples.load(std::memory_order_relaxed) +
+                               (uint64_t)std::max(numSamples, 0),
+                           std::memory_order_relaxed);
+      pendingSamples = 0;
+      return false;
+    }
+
+    pendingSamples = numSamples;
+    return true;
+  }
+
+  /** レーンにそのまま書く */
+  template <typename SampleType>
+  void writeLane(int lane, const SampleType *data) {
+    float *destination = getLane(lane);
+    size_t position = getWritePosition();
+
+    for (int i = 0; i < pendingSamples; ++i) {
+      destination[position] = (float)data[i];
+      position = (position + 1) & (kCapacity - 1);
+    }
+  }
+
+  /** チャンネルの平均（モノラル）をレーンに書く */
+  template <typename SampleType>
+  void writeMono(int lane, const SampleType *const *channels,
+                 int numChannels) {
+    float *destination = getLane(lane);
+    const size_t start = getWritePosition();
+    const float scale = numChannels > 0 ? 1.0f / (float)numChannels : 0.0f;
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+      const SampleType *data = channels[channel];
+      size_t position = start;
+
+      for (int i = 0; i < pendingSamples; ++i) {
+        const float sample = (float)data[i] * scale;
+        destination[position] =
+            channel == 0 ? sample : destination[position] + sample;
+        position = (position + 1) & (kCapacity - 1);
+      }
+    }
+  }
+
+  /** beginWrite() 以降に書いたレーンを公開する */
+  void commitWrite() {
+    writeIndex.store(writeIndex.load(std::memory_order_relaxed) +
+                         (uint64_t)pendingSamples,
+                     std::memory_order_release);
+    pendingSamples = 0;
+  }
+
+  //==============================================================================
+  // コンシューマー側
+
+  int getNumReady() const {
+    return (int)(writeIndex.load(std::memory_order_acquire) -
+                 readIndex.load(std::memory_order_relaxed));
+  }
+
+  /** 読み位置から numSamples 分を destination に写す（解放はしない） */
+  void read(int lane, float *destination, int numSamples) const {
+    const float *source =
+        storage.data() + (size_t)lane * (size_t)kCapacity;
+    const size_t start = (size_t)(readIndex.load(std::memory_order_relaxed) &
+                                  (kCapacity - 1));
+    const size_t first =
+        std::min((size_t)numSamples, (size_t)kCapacity - start);
+
+    std::copy(source + start, source + start + first, destination);
+    std::copy(source, source + ((size_t)numSamples - first),
+              destination + first);
+  }
+
+  void consume(int numSamples) {
+    readIndex.store(readIndex.load(std::memory_order_relaxed) +
+                        (uint64_t)numSamples,
+                    std::memory_order_release);
+  }
+
+  /** 溜まっている分を読まずに捨てる（解析を再開するとき） */
+  void discardAll() {
+    readIndex.store(writeIndex.load(std::memory_order_acquire),
+                    std::memory_order_release);
+  }
+
+  /** 空きが足りず捨てたサンプル数（prepare 以降の通算） */
+  uint64_t getNumDropped() const {
+    return droppedSamples.load(std::memory_order_relaxed);
+  }
+
+private:
+  float *getLane(int lane) {
+    return storage.data() + (size_t)lane * (size_t)kCapacity;
+  }
+
+  size_t getWritePosition() const {
+    return (size_t)(writeIndex.load(std::memory_order_relaxed) &
+                    (kCapacity - 1));
+  }
+
+  int lanes = 0;
+  std::vector<float> storage;
+
+  alignas(64) std::atomic<uint64_t> writeIndex{0};
+  std::atomic<uint64_t> droppedSamples{0};
+  int pendingSamples = 0; // プロデューサーだけが触る
+
+  alignas(64) std::atomic<uint64_t> readIndex{0};
+};
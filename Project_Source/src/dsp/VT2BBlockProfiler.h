@@ -0,0 +1,289 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Block Profiler
+
+    processBlock の 1 呼び出しごとの処理時間をヒストグラムに溜め、
+    中央値・p99・p99.9・最大を読み出す。平均ではなく、ドロップアウトの
+    原因になる最悪のブロックを見るためのもの。
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// プラグインでの計測の有無（-DVT2B_ENABLE_PROFILER=1、CMake では EA_VT_2B_ENABLE_PROFILER）。
+// 無効時はプロセッサ・エディターからメンバーごと外れる
+#ifndef VT2B_ENABLE_PROFILER
+#define VT2B_ENABLE_PROFILER 0
+#endif
+
+//==============================================================================
+/** 分布の要約（パーセンタイルはビンの上端、最大は実測値） */
+struct VT2BProfileDistribution {
+  double p50 = 0.0;
+  double p99 = 0.0;
+  double p999 = 0.0;
+  double max = 0.0;
+};
+
+struct VT2BProfileSummary {
+  uint64_t numBlocks = 0;
+  VT2BProfileDistribution nsPerSample;      // 1 サンプルあたりの処理時間（ns）
+  VT2BProfileDistribution deadlineFraction; // ブロックの締め切りに対する比（1 = 100%）
+};
+
+//==============================================================================
+/**
+ * ブロック単位の CPU プロファイラ
+ *
+ * 書き込みはオーディオスレッドだけが行い（単一ライター）、カウンタは relaxed な
+ * load / store で更新する（ロック・RMW 命令なし）。読み出し（エディター・ファイル出力）は
+ * 別スレッドから随時行ってよく、書き込み途中のブロックの分だけずれることがある。
+ * ヒストグラムは 1 オクターブを kBinsPerOctave 分割した対数ビン。
+ *
+ * 締め切りはホストのブロック長 / サンプルレート（prepare() で渡す）。
+ * ホストがブロックを分割して呼ぶ場合も、各呼び出しを同じ締め切りに対して数える。
+ */
+class VT2BBlockProfiler {
+public:
+  static constexpr int kBinsPerOctave = 8;
+  static constexpr int kNumOctaves = 16;
+  static constexpr int kNumBins = kBinsPerOctave * kNumOctaves;
+
+  // ビンの下端（ns/sample: 1/16 ns〜4 µs、締め切り比: 1/16384〜4）
+  static constexpr int kNsPerSampleMinExponent = -4;
+  static constexpr int kDeadlineMinExponent = -14;
+
+  //==============================================================================
+  /** 計測区間（デストラクタで記録する） */
+  class ScopedMeasurement {
+  public:
+    ScopedMeasurement(VT2BBlockProfiler &owner, int samples)
+        : profiler(owner), numSamples(samples),
+          start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedMeasurement() {
+      const auto elapsed = std::chrono::steady_clock::now() - start;
+      profiler.record(
+          std::chrono::duration<double, std::nano>(elapsed).count(),
+          numSamples);
+    }
+
+    ScopedMeasurement(const ScopedMeasurement &) = delete;
+    ScopedMeasurement &operator=(const ScopedMeasurement &) = delete;
+
+  private:
+    VT2BBlockProfiler &profiler;
+    int numSamples;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  //==============================================================================
+  /** 締め切りを設定する（オーディオスレッド外で呼ぶ）。記録は消さない */
+  void prepare(double sampleRate, int blockSize) {
+    if (sampleRate > 0.0 && blockSize > 0)
+      deadlineNs.store(1.0e9 * blockSize / sampleRate,
+                       std::memory_order_relaxed);
+  }
+
+  /** processBlock の先頭で受け取り、スコープの終わりまでを計る */
+  [[nodiscard]] ScopedMeasurement measure(int numSamples) {
+    return ScopedMeasurement(*this, numSamples);
+  }
+
+  /** 1 ブロック分を記録する（オーディオスレッド専用） */
+  void record(double elapsedNs, int numSamples) {
+    if (numSamples <= 0)
+      return;
+
+    if (resetRequested.load(std::memory_order_acquire)) {
+      clear();
+      resetRequested.store(false, std::memory_order_release);
+    }
+
+    const double nsPerSample = elapsedNs / numSamples;
+    const double fraction =
+        elapsedNs / deadlineNs.load(std::memory_order_relaxed);
+
+    increment(nsPerSampleBins[(size_t)getBin(nsPerSample,
+                                             kNsPerSampleMinExponent)]);
+    increment(deadlineBins[(size_t)getBin(fraction, kDeadlineMinExponent)]);
+    increment(numBlocks);
+
+    storeMax(maxNsPerSample, nsPerSample);
+    storeMax(maxDeadlineFraction, fraction);
+  }
+
+  //==============================================================================
+  /** 記録を消す（どのスレッドからでも。次のブロックでオーディオスレッドが消す） */
+  void reset() { resetRequested.store(true, std::memory_order_release); }
+
+  VT2BProfileSummary getSummary() const {
+    VT2BProfileSummary summary;
+    summary.numBlocks = numBlocks.load(std::memory_order_relaxed);
+    summary.nsPerSample =
+        summarise(nsPerSampleBins, kNsPerSampleMinExponent,
+                  maxNsPerSample.load(std::memory_order_relaxed));
+    summary.deadlineFraction =
+        summarise(deadlineBins, kDeadlineMinExponent,
+                  maxDeadlineFraction.load(std::memory_order_relaxed));
+    return summary;
+  }
+
+  /**
+   * 要約とヒストグラム（空でないビンのみ、CSV）のテキスト
+   * 文字列を組み立てるので、オーディオスレッドからは呼ばないこと。
+   */
+  std::string getReport() const {
+    const auto summary = getSummary();
+    const auto &ns = summary.nsPerSample;
+    const auto &deadline = summary.deadlineFraction;
+
+    std::string report;
+    appendFormatted(report, "# blocks %llu, deadline %.0f ns\n",
+                    (unsigned long long)summary.numBlocks,
+                    deadlineNs.load(std::memory_order_relaxed));
+    appendFormatted(report,
+                    "# ns/sample      p50 %.3g  p99 %.3g  p99.9 %.3g  "
+                    "max %.3g\n",
+                    ns.p50, ns.p99, ns.p999, ns.max);
+    appendFormatted(report,
+                    "# deadline (%%)  p50 %.3g  p99 %.3g  p99.9 %.3g  "
+                    "max %.3g\n",
+                    deadline.p50 * 100.0, deadline.p99 * 100.0,
+                    deadline.p999 * 100.0, deadline.max * 100.0);
+
+    report += "histogram,lower,upper,count\n";
+    appendBins(report, "ns_per_sample", nsPerSampleBins,
+               kNsPerSampleMinExponent);
+    appendBins(report, "deadline_fraction", deadlineBins,
+               kDeadlineMinExponent);
+    return report;
+  }
+
+private:
+  using Bins = std::array<std::atomic<uint32_t>, kNumBins>;
+
+  /** ビン番号（オクターブは指数、オクターブ内は仮数で線形に分ける） */
+  static int getBin(double value, int minExponent) {
+    if (!(value > 0.0))
+      return 0;
+
+    int exponent = 0;
+    const double mantissa = std::frexp(value, &exponent); // [0.5, 1)
+    const int octave = exponent - 1 - minExponent;
+    const int step = (int)((mantissa * 2.0 - 1.0) * kBinsPerOctave);
+    return std::clamp(octave * kBinsPerOctave + step, 0, kNumBins - 1);
+  }
+
+  static double getBinUpperEdge(int bin, int minExponent) {
+    const int octave = bin / kBinsPerOctave;
+    const int step = bin % kBinsPerOctave;
+    return std::ldexp(1.0 + (double)(step + 1) / kBinsPerOctave,
+                      octave + minExponent);
+  }
+
+  static double getBinLowerEdge(int bin, int minExponent) {
+    const int octave = bin / kBinsPerOctave;
+    const int step = bin % kBinsPerOctave;
+    return std::ldexp(1.0 + (double)step / kBinsPerOctave,
+                      octave + minExponent);
+  }
+
+  template <typename Counter> static void increment(Counter &counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+  }
+
+  static void storeMax(std::atomic<double> &maximum, double value) {
+    if (value > maximum.load(std::memory_order_relaxed))
+      maximum.store(value, std::memory_order_relaxed);
+  }
+
+  void clear() {
+    for (auto &bin : nsPerSampleBins)
+      bin.store(0, std::memory_order_relaxed);
+    for (auto &bin : deadlineBins)
+      bin.store(0, std::memory_order_relaxed);
+
+    numBlocks.store(0, std::memory_order_relaxed);
+    maxNsPerSample.store(0.0, std::memory_order_relaxed);
+    maxDeadlineFraction.store(0.0, std::memory_order_relaxed);
+  }
+
+  static VT2BProfileDistribution summarise(const Bins &bins, int minExponent,
+                                           double maximum) {
+    std::array<uint32_t, kNumBins> counts{};
+    uint64_t total = 0;
+
+    for (int i = 0; i < kNumBins; ++i) {
+      counts[(size_t)i] = bins[(size_t)i].load(std::memory_order_relaxed);
+      total += counts[(size_t)i];
+    }
+
+    VT2BProfileDistribution distribution;
+    distribution.max = maximum;
+
+    if (total == 0)
+      return distribution;
+
+    auto getPercentile = [&](double quantile) {
+      const double rank = quantile * (double)total;
+      uint64_t cumulative = 0;
+
+      for (int i = 0; i < kNumBins; ++i) {
+        cumulative += counts[(size_t)i];
+
+        if ((double)cumulative >= rank)
+          return std::min(getBinUpperEdge(i, minExponent), maximum);
+      }
+
+      return maximum;
+    };
+
+    distribution.p50 = getPercentile(0.5);
+    distribution.p99 = getPercentile(0.99);
+    distribution.p999 = getPercentile(0.999);
+    return distribution;
+  }
+
+  template <typename... Args>
+  static void appendFormatted(std::string &text, const char *format,
+                              Args... args) {
+    char line[160];
+    std::snprintf(line, sizeof(line), format, args...);
+    text += line;
+  }
+
+  static void appendBins(std::string &text, const char *name,
+                         const Bins &bins, int minExponent) {
+    for (int i = 0; i < kNumBins; ++i) {
+      const uint32_t count = bins[(size_t)i].load(std::memory_order_relaxed);
+
+      if (count > 0)
+        appendFormatted(text, "%s,%.6g,%.6g,%u\n", name,
+                        getBinLowerEdge(i, minExponent),
+                        getBinUpperEdge(i, minExponent), count);
+    }
+  }
+
+  Bins nsPerSampleBins{};
+  Bins deadlineBins{};
+  std::atomic<uint64_t> numBlocks{0};
+  std::atomic<double> maxNsPerSample{0.0};
+  std::atomic<double> maxDeadlineFraction{0.0};
+  std::atomic<double> deadlineNs{1.0e9 * 512 / 48000.0};
+  std::atomic<bool> resetRequested{false};
+
+  static_assert(std::atomic<double>::is_always_lock_free,
+                "the profiler must not lock on the audio thread");
+};
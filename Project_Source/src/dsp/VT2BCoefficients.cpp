@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Control-Rate Coefficient Engine Implementation
+  ==============================================================================
+*/
+
+#include "VT2BCoefficients.h"
+#include "VT2BConstants.h"
+#include "VT2BTrace.h"
+
+#include <cmath>
+
+//==============================================================================
+VT2BDriveCoefficients VT2BDriveCoefficients::fromDrive(float drive) {
+  VT2BDriveCoefficients c;
+  c.drive = drive;
+  c.normalizedDrive = drive / VT2BConstants::kDriveMax;
+
+  // 最大+9dB程度までブースト
+  c.preDriveGain = 1.0f + c.normalizedDrive * 1.5f;
+
+  c.saturationK = VT2BConstants::kSaturationCoeffMin +
+                  c.normalizedDrive * (VT2BConstants::kSaturationCoeffMax -
+                                       VT2BConstants::kSaturationCoeffMin);
+
+  c.transientAmount =
+      VT2BConstants::kTransientAmountMin +
+      c.normalizedDrive * (VT2BConstants::kTransientAmountMax -
+                           VT2BConstants::kTransientAmountMin);
+
+  // ブースト分を抑えつつ、サチュレーションでの圧縮感を残すバランス
+  c.makeupGain = 1.0f / (1.0f + c.normalizedDrive * 0.8f);
+  return c;
+}
+
+//==============================================================================
+void VT2BCoefficientEngine::prepare(double sampleRate, int maximumBlockSize) {
+  // スムージング設定（ジッパーノイズ防止）
+  smoothedDrive.reset(sampleRate, VT2BConstants::kSmoothingTimeSeconds);
+  smoothedMix.reset(sampleRate, VT2BConstants::kSmoothingTimeSeconds);
+
+  // エンベロープ係数はサンプルレートのみに依存
+  attackCoeff = 1.0f - std::exp(-1.0f / (float(sampleRate) *
+                                         VT2BConstants::kEnvelopeAttack));
+  releaseCoeff = 1.0f - std::exp(-1.0f / (float(sampleRate) *
+                                          VT2BConstants::kEnvelopeRelease));
+
+  staticCoefficients =
+      VT2BDriveCoefficients::fromDrive(smoothedDrive.getTargetValue());
+
+  normalizedDriveRamp.allocate(maximumBlockSize);
+  preDriveGainRamp.allocate(maximumBlockSize);
+  saturationKRamp.allocate(maximumBlockSize);
+  transientAmountRamp.allocate(maximumBlockSize);
+  makeupGainRamp.allocate(maximumBlockSize);
+  mixRamp.allocate(maximumBlockSize);
+}
+
+void VT2BCoefficientEngine::setDriveTarget(float newDrive) {
+  smoothedDrive.setTargetValue(newDrive);
+}
+
+void VT2BCoefficientEngine::setMixTarget(float newMix) {
+  smoothedMix.setTargetValue(newMix);
+}
+
+//==============================================================================
+const VT2BControlBlock &VT2BCoefficientEngine::computeBlock(int numSamples) {
+  block.numSamples = numSamples;
+
+  if (!isRamping()) {
+    // 静的ブロック: 目標値が変わったときだけ係数を再計算する
+    const float drive = smoothedDrive.getTargetValue();
+
+    if (drive != staticCoefficients.drive)
+      staticCoefficients = VT2BDriveCoefficients::fromDrive(drive);
+
+    block.ramping = false;
+    block.drive = staticCoefficients;
+    block.mix = smoothedMix.getTargetValue();
+    return block;
+  }
+
+  // ランプ中: スムーザーをサンプルごとに進めて係数列を展開
+  VT2B_TRACE_SCOPE("dsp", "smoothing ramp");
+  float *normalizedDrive = normalizedDriveRamp.get();
+  float *preDriveGain = preDriveGainRamp.get();
+  float *saturationK = saturationKRamp.get();
+  float *transientAmount = transientAmountRamp.get();
+  float *makeupGain = makeupGainRamp.get();
+  float *mix = mixRamp.get();
+
+  for (int i = 0; i < numSamples; ++i) {
+    normalizedDrive[i] =
+        smoothedDrive.getNextValue() / VT2BConstants::kDriveMax;
+    mix[i] = smoothedMix.getNextValue();
+  }
+
+  // 以下はベクトル化可能な独立ループ（fromDrive と同じ演算順）
+  for (int i = 0; i < numSamples; ++i) {
+    preDriveGain[i] = 1.0f + normalizedDrive[i] * 1.5f;
+    saturationK[i] = VT2BConstants::kSaturationCoeffMin +
+                     normalizedDrive[i] * (VT2BConstants::kSaturationCoeffMax -
+                                           VT2BConstants::kSaturationCoeffMin);
+    transientAmount[i] =
+        VT2BConstants::kTransientAmountMin +
+        normalizedDrive[i] * (VT2BConstants::kTransientAmountMax -
+                              VT2BConstants::kTransientAmountMin);
+    makeupGain[i] = 1.0f / (1.0f + normalizedDrive[i] * 0.8f);
+  }
+
+  block.ramping = true;
+  block.normalizedDrive = normalizedDrive;
+  block.preDriveGain = preDriveGain;
+  block.saturationK = saturationK;
+  block.transientAmount = transientAmount;
+  block.makeupGain = makeupGain;
+  block.mixRamp = mix;
+  return block;
+}
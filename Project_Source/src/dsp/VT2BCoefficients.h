@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Control-Rate Coefficient Engine
+
+    サンプルごとに再計算していた係数をブロック単位で用意する。
+    - サンプルレート依存の定数（エンベロープ係数）は prepare 時に一度だけ計算
+    - Drive由来の係数はスムーザー停止中はメモ化した値を使う
+    - ランプ中はブロック分の係数列を整列バッファに展開する
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "VT2BAlignedBuffer.h"
+#include "VT2BSmoothedValue.h"
+
+//==============================================================================
+/**
+ * Drive 値から導出される係数
+ * 演算順序は従来の per-sample 実装と同じで、値はビット一致する。
+ */
+struct VT2BDriveCoefficients {
+  float drive = 0.0f;
+  float normalizedDrive = 0.0f;  // drive / kDriveMax
+  float preDriveGain = 1.0f;     // 入力ブースト
+  float saturationK = 0.0f;      // サチュレーション係数 k
+  float transientAmount = 0.0f;  // トランジェント抑制量
+  float makeupGain = 1.0f;       // 自動ゲイン補償
+
+  static VT2BDriveCoefficients fromDrive(float drive);
+};
+
+//==============================================================================
+/**
+ * 1ブロック分の制御値
+ *
+ * ramping == false : スカラー値（drive / mix）のみ有効。超越関数・除算なし。
+ * ramping == true  : 各配列に numSamples 分の値が入っている（64バイト境界）。
+ */
+struct VT2BControlBlock {
+  int numSamples = 0;
+  bool ramping = false;
+
+  VT2BDriveCoefficients drive;
+  float mix = 1.0f;
+
+  const float *normalizedDrive = nullptr;
+  const float *preDriveGain = nullptr;
+  const float *saturationK = nullptr;
+  const float *transientAmount = nullptr;
+  const float *makeupGain = nullptr;
+  const float *mixRamp = nullptr;
+};
+
+//==============================================================================
+/**
+ * 係数エンジン
+ *
+ * Drive / Mix のスムージングを担当し、ブロックごとに VT2BControlBlock を返す。
+ */
+class VT2BCoefficientEngine {
+public:
+  /** サンプルレート定数の計算と作業バッファ確保（オーディオスレッド外） */
+  void prepare(double sampleRate, int maximumBlockSize);
+
+  void setDriveTarget(float newDrive);
+  void setMixTarget(float newMix);
+
+  /**
+   * 次の numSamples 分の制御値を生成してスムーザーを進める
+   * numSamples は prepare 時の maximumBlockSize 以下であること。
+   */
+  const VT2BControlBlock &computeBlock(int numSamples);
+
+  /** パラメータが目標値に到達しているか */
+  bool isRamping() const {
+    return smoothedDrive.isSmoothing() || smoothedMix.isSmoothing();
+  }
+
+  // エンベロープフォロワー係数（サンプルレートのみに依存）
+  float getAttackCoeff() const { return attackCoeff; }
+  float getReleaseCoeff() const { return releaseCoeff; }
+
+private:
+  VT2BSmoothedValue smoothedDrive;
+  VT2BSmoothedValue smoothedMix;
+
+  float attackCoeff = 0.0f;
+  float releaseCoeff = 0.0f;
+
+  // スムーザー停止中に使うメモ化済み係数
+  VT2BDriveCoefficients staticCoefficients =
+      VT2BDriveCoefficients::fromDrive(0.0f);
+
+  VT2BControlBlock block;
+
+  // ランプ用係数列
+  VT2BAlignedBuffer normalizedDriveRamp;
+  VT2BAlignedBuffer preDriveGainRamp;
+  VT2BAlignedBuffer saturationKRamp;
+  VT2BAlignedBuffer transientAmountRamp;
+  VT2BAlignedBuffer makeupGainRamp;
+  VT2BAlignedBuffer mixRamp;
+};
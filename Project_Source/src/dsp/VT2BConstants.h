@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    DSP Constants
+
+    プラグイン本体とDSPエンジンで共有する定数
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+// 定数 - 効果を分かりやすくするために強化
+namespace VT2BConstants {
+// サチュレーション - 効果を強く（ユーザー要望により大幅強化）
+constexpr float kSaturationCoeffMin = 0.0f;
+constexpr float kSaturationCoeffMax = 3.0f; // 0.8 -> 3.0
+constexpr float kSaturationCurve = 2.5f; // 1.5 -> 2.5 硬めのカーブで質感を出す
+
+// 倍音生成 - より明確に
+constexpr float kHarmonic2ndAmount = 0.40f; // 0.15 -> 0.40 (暖かさ)
+constexpr float kHarmonic3rdAmount = 0.25f; // 0.08 -> 0.25 (エッジ)
+
+// トランジェント - 音のアタック感を強調
+constexpr float kTransientThreshold = 0.2f;
+constexpr float kTransientKnee = 0.15f;
+constexpr float kTransientAmountMin = 0.08f;
+constexpr float kTransientAmountMax = 0.50f; // 0.25 -> 0.50
+constexpr float kEnvelopeAttack = 0.001f;
+constexpr float kEnvelopeRelease = 0.050f;
+
+// 無音検出（入力・出力・エンベロープがすべて下回ったら処理を止める）
+constexpr float kSilenceThreshold = 5.9604645e-8f; // 2^-24（24 bit の 1 LSB 未満）
+constexpr float kIdleEnvelopeLevel = 1.0e-4f; // -80 dB（しきい値より十分小さい）
+
+// バイパス切り替えのクロスフェード
+constexpr double kBypassFadeSeconds = 0.01; // 10ms
+
+// オーバーサンプリング / ADAA 設定の切り替えのクロスフェード（新旧のエンジン間）
+constexpr double kSettingsFadeSeconds = 0.02; // 20ms
+
+// オールパス（位相安定化）
+constexpr float kAllpassFrequency = 80.0f; // Hz
+
+// スムージング（ジッパーノイズ防止）
+constexpr double kSmoothingTimeSeconds = 0.02; // 20ms
+
+// パラメータ範囲
+constexpr float kDriveMin = 0.0f;
+constexpr float kDriveMax = 10.0f;
+constexpr float kDriveDefault = 0.0f;
+constexpr float kMixMin = 0.0f;
+constexpr float kMixMax = 100.0f;
+constexpr float kMixDefault = 100.0f;
+
+// オーバーサンプリング（0 = Off, 1 = 2x, 2 = 4x, 3 = 8x）
+constexpr int kOversamplingDefault = 0; // Off
+} // namespace VT2BConstants
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    CPU Feature Detection Implementation
+  ==============================================================================
+*/
+
+#include "VT2BCpuFeatures.h"
+
+#include <cstdint>
+
+#if VT2B_ARCH_X64
+#if defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace {
+#if VT2B_ARCH_X64
+void cpuid(int leaf, int subleaf, uint32_t regs[4]) {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuidex(info, leaf, subleaf);
+  for (int i = 0; i < 4; ++i)
+    regs[i] = (uint32_t)info[i];
+#else
+  __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+uint64_t readXcr0() {
+#if defined(_MSC_VER)
+  return _xgetbv(0);
+#else
+  uint32_t eax = 0, edx = 0;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return ((uint64_t)edx << 32) | eax;
+#endif
+}
+#endif
+
+VT2BSimdLevel detectSimdLevel() {
+#if VT2B_ARCH_X64
+  uint32_t regs[4] = {};
+  cpuid(0, 0, regs);
+  const uint32_t maxLeaf = regs[0];
+
+  // x86-64 では SSE2 は常に利用可能
+  auto level = VT2BSimdLevel::SSE2;
+
+  cpuid(1, 0, regs);
+  const bool osxsave = (regs[2] & (1u << 27)) != 0;
+  const bool avx = (regs[2] & (1u << 28)) != 0;
+
+  if (!osxsave || !avx || maxLeaf < 7)
+    return level;
+
+  // OSがYMM/ZMMレジスタを退避するか（XCR0）
+  const uint64_t xcr0 = readXcr0();
+  const bool osYmm = (xcr0 & 0x6) == 0x6;
+  const bool osZmm = (xcr0 & 0xe6) == 0xe6;
+
+  cpuid(7, 0, regs);
+  const bool avx2 = (regs[1] & (1u << 5)) != 0;
+  const bool avx512f = (regs[1] & (1u << 16)) != 0;
+  const bool avx512vl = (regs[1] & (1u << 31)) != 0;
+
+  if (osYmm && avx2)
+    level = VT2BSimdLevel::AVX2;
+
+  if (osZmm && avx2 && avx512f && avx512vl)
+    level = VT2BSimdLevel::AVX512;
+
+  return level;
+#elif VT2B_ARCH_ARM64
+  // AArch64 では NEON は必須機能
+  return VT2BSimdLevel::NEON;
+#else
+  return VT2BSimdLevel::Scalar;
+#endif
+}
+} // namespace
+
+//==============================================================================
+VT2BSimdLevel VT2BCpuFeatures::getBestSimdLevel() {
+  static const VT2BSimdLevel best = detectSimdLevel();
+  return best;
+}
+
+bool VT2BCpuFeatures::isSupported(VT2BSimdLevel level) {
+  const auto best = getBestSimdLevel();
+
+  if (level == VT2BSimdLevel::Scalar)
+    return true;
+
+  if (best == VT2BSimdLevel::NEON)
+    return level == VT2BSimdLevel::NEON;
+
+  return level != VT2BSimdLevel::NEON && (int)level <= (int)best;
+}
+
+const char *VT2BCpuFeatures::getName(VT2BSimdLevel level) {
+  switch (level) {
+  case VT2BSimdLevel::Scalar:
+    return "scalar";
+  case VT2BSimdLevel::SSE2:
+    return "sse2";
+  case VT2BSimdLevel::AVX2:
+    return "avx2";
+  case VT2BSimdLevel::AVX512:
+    return "avx512";
+  case VT2BSimdLevel::NEON:
+    return "neon";
+  }
+
+  return "unknown";
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    CPU Feature Detection
+
+    実行時にCPUの命令セットを判定し、使用するSIMDカーネルを選択する
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+// ビルド対象アーキテクチャ
+#if defined(__x86_64__) || defined(_M_X64)
+#define VT2B_ARCH_X64 1
+#else
+#define VT2B_ARCH_X64 0
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define VT2B_ARCH_ARM64 1
+#else
+#define VT2B_ARCH_ARM64 0
+#endif
+
+// 関数単位で命令セットを有効化（ファイル単位のコンパイルフラグを使わないため、
+// macOSのユニバーサルビルドでもそのままコンパイルできる）
+#if defined(__GNUC__) || defined(__clang__)
+#define VT2B_TARGET_AVX2 __attribute__((target("avx2")))
+// AVX-512 は VL も有効にする（スカラー部分で xmm16 以降を使うと、VL なしでは
+// zmm 全幅のコピーになり上位の状態が汚れて周囲の SSE コードが遅くなる）
+#define VT2B_TARGET_AVX512 __attribute__((target("avx512f,avx512vl")))
+#else
+#define VT2B_TARGET_AVX2
+#define VT2B_TARGET_AVX512
+#endif
+
+//==============================================================================
+/**
+ * SIMD命令セットのレベル
+ * 数値が大きいほど上位。Scalar はすべての環境で利用可能。
+ */
+enum class VT2BSimdLevel { Scalar = 0, SSE2, AVX2, AVX512, NEON };
+
+namespace VT2BCpuFeatures {
+/** このCPU/OSで実行可能な最上位のレベル（初回呼び出し時に判定してキャッシュ） */
+VT2BSimdLevel getBestSimdLevel();
+
+/** 指定レベルがこのCPU/OSで実行可能か */
+bool isSupported(VT2BSimdLevel level);
+
+/** ログ・ベンチマーク表示用の名前 */
+const char *getName(VT2BSimdLevel level);
+} // namespace VT2BCpuFeatures
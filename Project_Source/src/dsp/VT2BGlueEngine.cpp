@@ -0,0 +1,846 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Glue DSP Engine Implementation
+
+    設計思想:
+    - 非線形は控えめ、サチュレーションより「密度増加」
+    - 音をまとめる方向に作用
+    - バス・マスターで常時挿しておけるプロ仕様
+  ==============================================================================
+*/
+
+#include "VT2BGlueEngine.h"
+#include "VT2BConstants.h"
+#include "VT2BTrace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+//==============================================================================
+void VT2BGlueEngine::prepare(double sampleRate, int maximumBlockSize,
+                             int numChannels) {
+  currentSampleRate = sampleRate;
+  subBlockSize = std::min(maximumBlockSize, kSubBlockSize);
+  numChannels = std::clamp(numChannels, 0, kMaxChannels);
+  preparedChannels = numChannels;
+
+  // チャンネルをレーンに載せるカーネル用に、状態と Wet は最大 SIMD 幅の倍数分持つ
+  constexpr int lanes = VT2BKernels::kMaxLanes;
+  paddedChannels = (numChannels + lanes - 1) / lanes * lanes;
+  envelopeState.allocate(paddedChannels);
+  allpassState.allocate(paddedChannels);
+
+  // 作業バッファはすべてサブブロック長（Wet とエンベロープはチャンネル分並べる）
+  scratchStride = (subBlockSize + kScratchAlignment - 1) / kScratchAlignment *
+                  kScratchAlignment;
+  wetBuffer.allocate(scratchStride * paddedChannels);
+  envelopeBuffer.allocate(scratchStride * numChannels);
+  wetInputBuffer.allocate(scratchStride * numChannels);
+  dryHistoryBuffer.allocate(kWarmupLength * numChannels);
+
+  // オーバーサンプラーと高レート作業バッファ
+  oversampler.prepare(numChannels, subBlockSize,
+                      oversamplingFactorLog2, oversamplingFilter);
+
+  const int oversampledSize = subBlockSize * oversampler.getFactor();
+  oversampledBuffer.allocate(oversampledSize);
+  oversampledNormalizedDrive.allocate(oversampledSize);
+  oversampledPreDriveGain.allocate(oversampledSize);
+  oversampledSaturationK.allocate(oversampledSize);
+
+  shapeTable.prepare();
+
+  // ADAA は処理レート（オーバーサンプリング後）で動く
+  saturationADAA.setMode(antialiasing);
+  saturationADAA.prepare(numChannels);
+
+  // Dry 側のレイテンシ補償（小数遅延は最も近い整数に丸める）
+  latencySamples = (int)std::lround(
+      oversampler.getLatencyInSamples() +
+      saturationADAA.getDelayInSamples() / oversampler.getFactor());
+  delayedDryBuffer.allocate(subBlockSize);
+  delayedDryBufferDouble.allocate(subBlockSize);
+  dryDelayLines.assign((size_t)numChannels,
+                       std::vector<double>((size_t)std::max(latencySamples, 1)));
+  dryDelayPositions.assign((size_t)numChannels, 0);
+
+  // 無音が続いてからフィルタ・ディレイの中身が出切るまで待つ
+  idleSettleLength = 2 * latencySamples + kWarmupLength;
+
+  bypassFadeRamp.allocate(subBlockSize);
+  bypassFadeStep = (float)(1.0 / std::max(1.0, VT2BConstants::kBypassFadeSeconds *
+                                                   sampleRate));
+
+  // スムージング設定とサンプルレート定数の計算
+  coefficients.prepare(sampleRate, subBlockSize);
+
+  reset();
+}
+
+void VT2BGlueEngine::reset() {
+  // 状態リセット
+  std::fill(envelopeState.get(), envelopeState.get() + paddedChannels, 0.0f);
+  std::fill(allpassState.get(), allpassState.get() + paddedChannels, 0.0f);
+
+  wetChainSuspended = false;
+  envelopeSuspended = false;
+  processedGain = bypassed ? 0.0f : 1.0f;
+
+  oversampler.reset();
+  saturationADAA.reset();
+
+  suspendedLength = 0;
+
+  for (auto &line : dryDelayLines)
+    std::fill(line.begin(), line.end(), 0.0);
+
+  std::fill(dryDelayPositions.begin(), dryDelayPositions.end(), 0);
+
+  idle = false;
+  silentSamples = 0;
+  quantumPosition = 0;
+}
+
+double VT2BGlueEngine::getTailLengthSeconds() const {
+  const double envelopeDecay =
+      VT2BConstants::kEnvelopeRelease *
+      std::log(1.0 / (double)VT2BConstants::kIdleEnvelopeLevel);
+
+  return envelopeDecay + idleSettleLength / currentSampleRate;
+}
+
+void VT2BGlueEngine::setDrive(float newDrive) {
+  coefficients.setDriveTarget(newDrive);
+}
+
+void VT2BGlueEngine::setMix(float newMix) { coefficients.setMixTarget(newMix); }
+
+void VT2BGlueEngine::setSimdLevel(VT2BSimdLevel level) {
+  simdLevel = level;
+  kernels = &VT2BKernels::get(simdLevel, curvePrecision);
+}
+
+void VT2BGlueEngine::setCurvePrecision(VT2BCurvePrecision precision) {
+  curvePrecision = precision;
+  kernels = &VT2BKernels::get(simdLevel, curvePrecision);
+}
+
+void VT2BGlueEngine::setOversampling(int factorLog2,
+                                     VT2BOversamplingFilter filterType) {
+  oversamplingFactorLog2 =
+      std::clamp(factorLog2, 0, VT2BOversampler::kMaxFactorLog2);
+  oversamplingFilter = filterType;
+}
+
+void VT2BGlueEngine::setAntialiasing(VT2BAntialiasing mode) {
+  antialiasing = mode;
+}
+
+void VT2BGlueEngine::setEnvelopeLink(VT2BEnvelopeLink link) {
+  if (link == envelopeLink)
+    return;
+
+  const bool wasLinked = isEnvelopeLinked();
+  envelopeLink = link;
+
+  if (wasLinked == isEnvelopeLinked())
+    return;
+
+  // 切り替え時に抑制量が飛ばないよう状態を引き継ぐ
+  float *state = envelopeState.get();
+
+  if (wasLinked) {
+    std::fill(state + 1, state + preparedChannels, state[0]);
+  } else if (link == VT2BEnvelopeLink::Average) {
+    float sum = 0.0f;
+
+    for (int channel = 0; channel < preparedChannels; ++channel)
+      sum += state[channel];
+
+    state[0] = sum / (float)preparedChannels;
+  } else {
+    state[0] = *std::max_element(state, state + preparedChannels);
+  }
+}
+
+//==============================================================================
+void VT2BGlueEngine::process(float *const *channels, int numChannels,
+                             int numSamples) {
+  process(channels, channels, numChannels, numSamples);
+}
+
+void VT2BGlueEngine::process(const float *const *inputs,
+                             float *const *outputs, int numChannels,
+                             int numSamples) {
+  processBlock(inputs, outputs, numChannels, numSamples);
+}
+
+void VT2BGlueEngine::process(double *const *channels, int numChannels,
+                             int numSamples) {
+  process(channels, channels, numChannels, numSamples);
+}
+
+void VT2BGlueEngine::process(const double *const *inputs,
+                             double *const *outputs, int numChannels,
+                             int numSamples) {
+  processBlock(inputs, outputs, numChannels, numSamples);
+}
+
+template <typename SampleType>
+void VT2BGlueEngine::processBlock(const SampleType *const *inputs,
+                                  SampleType *const *outputs, int numChannels,
+                                  int numSamples) {
+  numChannels = std::min(numChannels, getNumChannels());
+
+  if (subBlockSize <= 0)
+    return;
+
+  // サブブロックに分けて処理する（ホストが prepare 時より大きいブロックを
+  // 渡しても作業バッファ内で収まる）。量子に揃える場合は格子の境界で切る
+  for (int start = 0, length = 0; start < numSamples; start += length) {
+    length = std::min(subBlockSize - quantumPosition, numSamples - start);
+
+    if (quantumAligned)
+      quantumPosition = (quantumPosition + length) % subBlockSize;
+
+    // 係数（静的ブロックなら再計算なし、ランプ中はサンプルごとの係数列）
+    const auto &control = coefficients.computeBlock(length);
+    VT2B_TRACE_SCOPE_IF(control.ramping, "dsp", "ramping sub-block");
+
+    // バイパス中は DSP を回さない（無音検出も不要）
+    if (!advanceBypassFade(length)) {
+      processBypassed(inputs, outputs, numChannels, start, control);
+      guardNonFinite(outputs, numChannels, start, length);
+      continue;
+    }
+
+    const bool silent = isSilent(inputs, numChannels, start, length);
+
+    // アイドル中: 無音が続き係数も止まっていれば処理せず無音を書く
+    if (idle && silent && !control.ramping) {
+      for (int channel = 0; channel < numChannels; ++channel)
+        std::fill(outputs[channel] + start, outputs[channel] + start + length,
+                  SampleType(0));
+      continue;
+    }
+
+    idle = false;
+    processSubBlock(inputs, outputs, numChannels, start, control);
+    guardNonFinite(outputs, numChannels, start, length);
+    updateIdle(outputs, numChannels, start, silent, control);
+
+    if (gainReductionMetering)
+      meterGainReduction(control);
+  }
+}
+
+bool VT2BGlueEngine::advanceBypassFade(int numSamples) {
+  const float target = bypassed ? 0.0f : 1.0f;
+  bypassFading = processedGain != target;
+
+  if (!bypassFading)
+    return !bypassed;
+
+  // 線形フェード（目標に届いたらそこで止める）
+  float *ramp = bypassFadeRamp.get();
+  const float step = bypassed ? -bypassFadeStep : bypassFadeStep;
+
+  for (int i = 0; i < numSamples; ++i) {
+    processedGain = std::clamp(processedGain + step, 0.0f, 1.0f);
+    ramp[i] = processedGain;
+  }
+
+  return true;
+}
+
+template <typename SampleType>
+void VT2BGlueEngine::processBypassed(const SampleType *const *inputs,
+                                     SampleType *const *outputs,
+                                     int numChannels, int startSample,
+                                     const VT2BControlBlock &control) {
+  VT2B_TRACE_SCOPE("dsp", "bypassed");
+  const int numSamples = control.numSamples;
+
+  // Mix 0% から入った場合、シェイプ段に状態がなければ履歴は使われていない
+  if (!envelopeSuspended && !hasShapeState())
+    suspendedLength = 0;
+
+  for (int channel = 0; channel < numChannels; ++channel) {
+    const SampleType *dry = inputs[channel] + startSample;
+    SampleType *output = outputs[channel] + startSample;
+
+    // 戻るときにエンベロープとシェイプ段を慣らすため、直近の入力だけ残す
+    rememberDry(channel, getWetInput(channel, dry, numSamples), numSamples);
+
+    if (latencySamples > 0)
+      delayDry(channel, dry, output, numSamples);
+    else if (output != dry)
+      std::copy(dry, dry + numSamples, output);
+  }
+
+  // 無音検出はバイパス中は止める（戻ったら数え直す）
+  idle = false;
+  silentSamples = 0;
+
+  suspendedDrive = control.drive;
+  suspendedLength = std::min(suspendedLength + numSamples, kWarmupLength + 1);
+  wetChainSuspended = true;
+  envelopeSuspended = true;
+}
+
+template <typename SampleType>
+void VT2BGlueEngine::applyBypassFade(const SampleType *dry, SampleType *output,
+                                     int numSamples) const {
+  const float *ramp = bypassFadeRamp.get();
+
+  for (int i = 0; i < numSamples; ++i)
+    output[i] = dry[i] + (output[i] - dry[i]) * (SampleType)ramp[i];
+}
+
+bool VT2BGlueEngine::isSilent(const double *channel, int numSamples) const {
+  bool silent = true;
+
+  // NaN は比較が偽になるので無音としない
+  for (int i = 0; i < numSamples; ++i)
+    silent &= std::abs(channel[i]) <= VT2BConstants::kSilenceThreshold;
+
+  return silent;
+}
+
+template <typename SampleType>
+bool VT2BGlueEngine::isSilent(const SampleType *const *channels,
+                              int numChannels, int startSample,
+                              int numSamples) const {
+  for (int channel = 0; channel < numChannels; ++channel)
+    if (!isSilent(channels[channel] + startSample, numSamples))
+      return false;
+
+  return true;
+}
+
+template <typename SampleType>
+void VT2BGlueEngine::updateIdle(SampleType *const *outputs, int numChannels,
+                                int startSample, bool inputSilent,
+                                const VT2BControlBlock &control) {
+  if (!inputSilent) {
+    silentSamples = 0;
+    return;
+  }
+
+  silentSamples = std::min(silentSamples + control.numSamples,
+                           idleSettleLength);
+
+  // 量子に揃える場合は量子の終わりでだけ判定する
+  if (control.ramping || silentSamples < idleSettleLength ||
+      quantumPosition != 0)
+    return;
+
+  // リンク時は envelopeState[0] だけが使われる
+  const int numStates = isEnvelopeLinked() ? 1 : preparedChannels;
+
+  for (int channel = 0; channel < numStates; ++channel)
+    if (!(envelopeState.get()[channel] <= VT2BConstants::kIdleEnvelopeLevel))
+      return;
+
+  if (!isSilent(outputs, numChannels, startSample, control.numSamples))
+    return;
+
+  // しきい値以下の残りを消してアイドルに入る
+  reset();
+  idle = true;
+}
+
+namespace {
+// 有限なら x - x == 0、NaN / ±Inf なら NaN（分岐なしで最後まで回す）
+template <typename SampleType>
+bool isFiniteSamples(const SampleType *samples, int numSamples) {
+  bool finite = true;
+
+  for (int i = 0; i < numSamples; ++i)
+    finite &= samples[i] - samples[i] == SampleType(0);
+
+  return finite;
+}
+} // namespace
+
+bool VT2BGlueEngine::isFinite(const float *channel, int numSamples) const {
+  // 数サンプルならカーネルの呼び出しの方が重い
+  if (numSamples < kernels->shortBlockLength)
+    return isFiniteSamples(channel, numSamples);
+
+  return kernels->isFinite(channel, numSamples);
+}
+
+bool VT2BGlueEngine::isFinite(const double *channel, int numSamples) const {
+  return isFiniteSamples(channel, numSamples);
+}
+
+template <typename SampleType>
+void VT2BGlueEngine::guardNonFinite(SampleType *const *outputs,
+                                    int numChannels, int startSample,
+                                    int numSamples) {
+  // リンク時は envelopeState[0] だけが使われる
+  const bool linked = isEnvelopeLinked();
+  const float *state = envelopeState.get();
+
+  for (int channel = 0; channel < numChannels; ++channel) {
+    SampleType *output = outputs[channel] + startSample;
+    const float envelope = state[linked ? 0 : channel];
+
+    if (envelope - envelope == 0.0f && isFinite(output, numSamples))
+      continue;
+
+    VT2B_TRACE_SCOPE("dsp", "non-finite recovery");
+
+    for (int i = 0; i < numSamples; ++i)
+      if (!(output[i] - output[i] == SampleType(0)))
+        output[i] = SampleType(0);
+
+    recoverChannel(channel);
+    nonFiniteEvents.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void VT2BGlueEngine::recoverChannel(int channel) {
+  float *state = envelopeState.get();
+  state[channel] = 0.0f;
+
+  if (isEnvelopeLinked())
+    state[0] = 0.0f;
+
+  oversampler.reset(channel);
+  saturationADAA.reset(channel);
+
+  // 遅延中・履歴中の有限なサンプルは残す（NaN だけ後から出ないように）
+  for (auto &sample : dryDelayLines[(size_t)channel])
+    if (!(sample - sample == 0.0))
+      sample = 0.0;
+
+  float *history = getDryHistory(channel);
+
+  for (int i = 0; i < kWarmupLength; ++i)
+    if (!(history[i] - history[i] == 0.0f))
+      history[i] = 0.0f;
+}
+
+void VT2BGlueEngine::meterGainReduction(const VT2BControlBlock &control) {
+  const float amount = control.ramping
+                           ? control.transientAmount[control.numSamples - 1]
+                           : control.drive.transientAmount;
+
+  // リンク時は envelopeState[0] だけが使われる
+  const int numStates = isEnvelopeLinked() ? 1 : preparedChannels;
+  const float *state = envelopeState.get();
+  float envelope = 0.0f;
+
+  for (int channel = 0; channel < numStates; ++channel)
+    envelope = std::max(envelope, state[channel]);
+
+  // transientGainSample と同じ式（NaN は抑制なし）
+  float excess = (envelope - VT2BConstants::kTransientThreshold) /
+                 VT2BConstants::kTransientKnee;
+  excess = excess >= 0.0f ? std::min(excess, 1.0f) : 0.0f;
+
+  minimumTransientGain = std::min(minimumTransientGain, 1.0f - excess * amount);
+}
+
+template <typename SampleType>
+void VT2BGlueEngine::processSubBlock(const SampleType *const *inputs,
+                                     SampleType *const *outputs,
+                                     int numChannels, int startSample,
+                                     const VT2BControlBlock &control) {
+  const int numSamples = control.numSamples;
+
+  // Drive 固定なら伝達関数表を使う（未完成の間はブロックごとに構築を進める）
+  activeLookup = nullptr;
+
+  if (shapeTableEnabled && kernels->prefersShapeLookup && !control.ramping &&
+      antialiasing == VT2BAntialiasing::Off) {
+    VT2B_TRACE_SCOPE("dsp", "shape table");
+    activeLookup = shapeTable.update(control.drive, numSamples);
+  }
+
+  // Mix 0%（静的）: Wet 系を止め、レイテンシを揃えた Dry をそのまま出す
+  if (!control.ramping && control.mix == 0.0f) {
+    processFullyDry(inputs, outputs, numChannels, startSample, control);
+    return;
+  }
+
+  if (wetChainSuspended)
+    resumeWetChain();
+
+  // 短いブロック: 全段を 1 回のカーネル呼び出しで回す（段ごとの呼び出しと
+  // 作業バッファの往復が、数サンプルのブロックでは処理本体より重いため）
+  if constexpr (std::is_same_v<SampleType, float>) {
+    if (canProcessShortBlock(numSamples)) {
+      VT2B_TRACE_SCOPE("dsp", "short block");
+      kernels->processShortBlock(inputs, outputs, numChannels, startSample,
+                                 envelopeState.get(), activeLookup, control,
+                                 coefficients.getAttackCoeff(),
+                                 coefficients.getReleaseCoeff());
+      return;
+    }
+  }
+
+  // 高レート側の係数（全チャンネル共通なのでブロックごとに一度だけ展開）
+  const bool oversampling = oversampler.getFactor() > 1;
+  const auto &shapeControl =
+      oversampling ? getOversampledControl(control) : control;
+
+  // ステージごとに全チャンネルを処理する
+  // インプレースでも outputs は 5. まで書かないので、inputs（Dry）は保たれる
+
+  // 1. サチュレーション（密度増加） + 2. 倍音生成
+  // 入力ブースト (Pre-Drive Gain) もカーネル内で適用する
+  for (int channel = 0; channel < numChannels; ++channel) {
+    VT2B_TRACE_SCOPE("dsp", "saturation + harmonics");
+    const float *dry =
+        getWetInput(channel, inputs[channel] + startSample, numSamples);
+
+    if (oversampling)
+      processShapeOversampled(channel, dry, getWet(channel), shapeControl);
+    else
+      processShape(channel, dry, getWet(channel), control);
+  }
+
+  // 3. トランジェント整形
+  // エンベロープの再帰だけをシリアルに回し（チャンネル間は並列）、
+  // ゲイン計算は別パスにする
+  {
+    VT2B_TRACE_SCOPE("dsp", "envelope follower");
+    followEnvelopes(numChannels, numSamples);
+  }
+
+  const bool linked = isEnvelopeLinked();
+
+  for (int channel = 0; channel < numChannels; ++channel) {
+    VT2B_TRACE_SCOPE("dsp", "transient gain");
+    kernels->transientGain(getWet(channel), getEnvelope(linked ? 0 : channel),
+                           control);
+  }
+
+  // 4. 位相安定化 (Allpass) -> 廃止
+  // 原音の位相・キャラクターを維持するため、位相シフトを行わない
+
+  // 5. ゲイン補償 + Dry/Wet ミックス（Dry はレイテンシを揃えてから）
+  for (int channel = 0; channel < numChannels; ++channel) {
+    VT2B_TRACE_SCOPE("dsp", "makeup + mix");
+    const SampleType *dry = inputs[channel] + startSample;
+    SampleType *output = outputs[channel] + startSample;
+
+    // クロスフェード中はバイパス音（遅延した Dry）を残しておく
+    if (latencySamples > 0) {
+      SampleType *delayed = getDelayedDry(dry);
+      delayDry(channel, dry, delayed, numSamples);
+      dry = delayed;
+    } else if (bypassFading && output == dry) {
+      SampleType *copied = getDelayedDry(dry);
+      std::copy(dry, dry + numSamples, copied);
+      dry = copied;
+    }
+
+    makeupAndMix(dry, getWet(channel), output, control);
+
+    if (bypassFading)
+      applyBypassFade(dry, output, numSamples);
+  }
+}
+
+bool VT2BGlueEngine::canProcessShortBlock(int numSamples) const {
+  // 遅延 Dry とバイパスのクロスフェードは段ごとの経路でのみ扱う
+  return numSamples < kernels->shortBlockLength &&
+         oversampler.getFactor() == 1 &&
+         antialiasing == VT2BAntialiasing::Off && !isEnvelopeLinked() &&
+         latencySamples == 0 && !bypassFading;
+}
+
+const float *VT2BGlueEngine::getWetInput(int channel, const double *dry,
+                                         int numSamples) {
+  float *converted = wetInputBuffer.get() + channel * scratchStride;
+
+  for (int i = 0; i < numSamples; ++i)
+    converted[i] = (float)dry[i];
+
+  return converted;
+}
+
+void VT2BGlueEngine::makeupAndMix(const double *dry, const float *wet,
+                                  double *output,
+                                  const VT2BControlBlock &control) {
+  // float 版と同じ式を double で評価する（Dry の精度を落とさない）
+  const int numSamples = control.numSamples;
+
+  if (control.ramping) {
+    for (int i = 0; i < numSamples; ++i) {
+      const double mix = control.mixRamp[i];
+      output[i] = dry[i] * (1.0 - mix) +
+                  (double)wet[i] * (double)control.makeupGain[i] * mix;
+    }
+  } else if (control.mix == 1.0f) {
+    const double makeupGain = control.drive.makeupGain;
+
+    for (int i = 0; i < numSamples; ++i)
+      output[i] = (double)wet[i] * makeupGain;
+  } else {
+    const double makeupGain = control.drive.makeupGain;
+    const double mix = control.mix;
+
+    for (int i = 0; i < numSamples; ++i)
+      output[i] = dry[i] * (1.0 - mix) + (double)wet[i] * makeupGain * mix;
+  }
+}
+
+template <typename SampleType>
+void VT2BGlueEngine::processFullyDry(const SampleType *const *inputs,
+                                     SampleType *const *outputs,
+                                     int numChannels, int startSample,
+                                     const VT2BControlBlock &control) {
+  VT2B_TRACE_SCOPE("dsp", "fully dry");
+  const int numSamples = control.numSamples;
+
+  // バイパスから Mix 0% に戻った: 先にエンベロープを追いつかせる
+  if (envelopeSuspended)
+    resumeWetChain();
+
+  const bool statefulShape = hasShapeState();
+
+  for (int channel = 0; channel < numChannels; ++channel) {
+    const SampleType *dry = inputs[channel] + startSample;
+    SampleType *output = outputs[channel] + startSample;
+
+    // エンベロープ用のシェイプ（出力で Dry を上書きする前に）
+    // オーバーサンプリング・ADAA 使用時は処理レートのカーネルで近似する
+    const float *wetInput = getWetInput(channel, dry, numSamples);
+
+    if (activeLookup != nullptr)
+      kernels->shapeLookup(wetInput, getWet(channel), *activeLookup, control);
+    else
+      kernels->shape(wetInput, getWet(channel), control);
+
+    // 状態を持つシェイプ段は再開時に流し直す
+    if (statefulShape)
+      rememberDry(channel, wetInput, numSamples);
+
+    // dry * 1 + wet * makeup * 0 と同値（Wet が有限なら）
+    if (latencySamples > 0)
+      delayDry(channel, dry, output, numSamples);
+    else if (output != dry)
+      std::copy(dry, dry + numSamples, output);
+  }
+
+  // エンベロープは止めずに追従させ、再開時のトランジェント整形を連続させる
+  // （シェイプ段に状態がなければ、止めなかった場合と同じ値になる）
+  followEnvelopes(numChannels, numSamples);
+
+  suspendedDrive = control.drive;
+  suspendedLength = std::min(suspendedLength + numSamples, kWarmupLength + 1);
+  wetChainSuspended = true;
+}
+
+void VT2BGlueEngine::rememberDry(int channel, const float *input,
+                                 int numSamples) {
+  float *history = getDryHistory(channel);
+  const int keep = kWarmupLength - numSamples;
+
+  // 古い側を詰めてから末尾に追加（numSamples <= subBlockSize < kWarmupLength）
+  std::copy(history + numSamples, history + kWarmupLength, history);
+  std::copy(input, input + numSamples, history + keep);
+}
+
+void VT2BGlueEngine::resumeWetChain() {
+  VT2B_TRACE_SCOPE("dsp", "resume wet chain");
+  const bool replayEnvelope = envelopeSuspended;
+  wetChainSuspended = false;
+  envelopeSuspended = false;
+
+  if (!hasShapeState() && !replayEnvelope) {
+    suspendedLength = 0;
+    return;
+  }
+
+  // 止めていた間の入力をオーバーサンプラー / ADAA に流し直して状態を
+  // 追いつかせる（出力は捨てる）。全部残っていれば止めなかった場合と同じ状態に
+  // なる。長く止めていた場合は無音の状態から直近 kWarmupLength サンプルで慣らす
+  // （無音から直接再開すると、オーバーサンプラーの IIR がナイキスト付近で
+  // 長く鳴る）
+  // バイパスからはエンベロープも同様（短ければ止めた時点の状態から続ける）
+  if (suspendedLength > kWarmupLength) {
+    oversampler.reset();
+    saturationADAA.reset();
+
+    if (replayEnvelope)
+      std::fill(envelopeState.get(), envelopeState.get() + paddedChannels,
+                0.0f);
+  }
+
+  // 止めていた間の Drive は静的（Mix 0% の判定は静的ブロックのみ）
+  VT2BControlBlock replay;
+  replay.drive = suspendedDrive;
+
+  const auto *lookup = activeLookup;
+  activeLookup = nullptr;
+
+  const int first = kWarmupLength - std::min(suspendedLength, kWarmupLength);
+
+  for (int start = first; start < kWarmupLength; start += subBlockSize) {
+    replay.numSamples = std::min(subBlockSize, kWarmupLength - start);
+    const auto &shapeControl = oversampler.getFactor() > 1
+                                   ? getOversampledControl(replay)
+                                   : replay;
+
+    for (int channel = 0; channel < getNumChannels(); ++channel) {
+      const float *history = getDryHistory(channel) + start;
+
+      if (oversampler.getFactor() > 1)
+        processShapeOversampled(channel, history, getWet(channel),
+                                shapeControl);
+      else
+        processShape(channel, history, getWet(channel), replay);
+    }
+
+    if (replayEnvelope)
+      followEnvelopes(getNumChannels(), replay.numSamples);
+  }
+
+  activeLookup = lookup;
+  suspendedLength = 0;
+}
+
+void VT2BGlueEngine::processShape(int channel, const float *input,
+                                  float *wet,
+                                  const VT2BControlBlock &control) {
+  if (antialiasing != VT2BAntialiasing::Off)
+    saturationADAA.process(channel, input, wet, control);
+  else if (activeLookup != nullptr)
+    kernels->shapeLookup(input, wet, *activeLookup, control);
+  else
+    kernels->shape(input, wet, control);
+}
+
+void VT2BGlueEngine::processShapeOversampled(
+    int channel, const float *dry, float *wet,
+    const VT2BControlBlock &oversampledBlock) {
+  const int numSamples = oversampledBlock.numSamples / oversampler.getFactor();
+  float *upsampled = oversampledBuffer.get();
+
+  {
+    VT2B_TRACE_SCOPE("dsp", "upsample");
+    oversampler.upsample(channel, dry, upsampled, numSamples);
+  }
+
+  // カーネル・ADAA とも入出力が同じバッファでも良い
+  processShape(channel, upsampled, upsampled, oversampledBlock);
+
+  VT2B_TRACE_SCOPE("dsp", "downsample");
+  oversampler.downsample(channel, upsampled, wet, numSamples);
+}
+
+const VT2BControlBlock &
+VT2BGlueEngine::getOversampledControl(const VT2BControlBlock &control) {
+  const int factor = oversampler.getFactor();
+
+  oversampledControl = control;
+  oversampledControl.numSamples = control.numSamples * factor;
+
+  if (!control.ramping)
+    return oversampledControl;
+
+  float *normalizedDrive = oversampledNormalizedDrive.get();
+  float *preDriveGain = oversampledPreDriveGain.get();
+  float *saturationK = oversampledSaturationK.get();
+
+  for (int i = 0; i < control.numSamples; ++i) {
+    for (int j = 0; j < factor; ++j) {
+      normalizedDrive[i * factor + j] = control.normalizedDrive[i];
+      preDriveGain[i * factor + j] = control.preDriveGain[i];
+      saturationK[i * factor + j] = control.saturationK[i];
+    }
+  }
+
+  oversampledControl.normalizedDrive = normalizedDrive;
+  oversampledControl.preDriveGain = preDriveGain;
+  oversampledControl.saturationK = saturationK;
+  return oversampledControl;
+}
+
+template <typename SampleType>
+void VT2BGlueEngine::delayDry(int channel, const SampleType *input,
+                              SampleType *output, int numSamples) {
+  auto &line = dryDelayLines[(size_t)channel];
+  int position = dryDelayPositions[(size_t)channel];
+
+  // ブロックがディレイより長ければまとめてコピーする
+  // 出力 = [ディレイの中身, 入力の先頭]、ディレイ = 入力の末尾
+  if (numSamples >= latencySamples) {
+    const int head = numSamples - latencySamples;
+
+    // インプレースなら入力を作業バッファに退避（delayedDry は使っていない）
+    if (output == input) {
+      SampleType *saved = getDelayedDry(input);
+      std::copy(input, input + numSamples, saved);
+      input = saved;
+    }
+
+    const auto start = line.begin() + position;
+    std::copy(start, line.end(), output);
+    std::copy(line.begin(), start, output + (line.end() - start));
+    std::copy(input, input + head, output + latencySamples);
+    std::copy(input + head, input + numSamples, line.begin());
+
+    dryDelayPositions[(size_t)channel] = 0;
+    return;
+  }
+
+  // output と input が同じバッファでも良いよう、先に入力を読む
+  for (int i = 0; i < numSamples; ++i) {
+    const SampleType sample = input[i];
+    output[i] = (SampleType)line[(size_t)position];
+    line[(size_t)position] = sample;
+
+    if (++position == latencySamples)
+      position = 0;
+  }
+
+  dryDelayPositions[(size_t)channel] = position;
+}
+
+//==============================================================================
+// DSP処理関数実装
+
+void VT2BGlueEngine::followEnvelopes(int numChannels, int numSamples) {
+  // 係数は prepare 時に計算済み
+  if (isEnvelopeLinked()) {
+    kernels->followLinkedEnvelope(
+        wetBuffer.get(), envelopeBuffer.get(), scratchStride,
+        envelopeState.get(), numChannels, numSamples,
+        coefficients.getAttackCoeff(), coefficients.getReleaseCoeff(),
+        envelopeLink);
+    return;
+  }
+
+  kernels->followEnvelopes(wetBuffer.get(), envelopeBuffer.get(), scratchStride,
+                           envelopeState.get(), numChannels, numSamples,
+                           coefficients.getAttackCoeff(),
+                           coefficients.getReleaseCoeff());
+}
+
+// 保持（現在は未使用）
+float VT2BGlueEngine::processAllpass(float input, float &state) const {
+  // 1次オールパスフィルタ（位相安定化）
+  // 低域の位相を安定させ、ステレオ像を維持
+
+  constexpr float pi = 3.14159265358979323846f;
+
+  float omega =
+      2.0f * pi * VT2BConstants::kAllpassFrequency / float(currentSampleRate);
+  float coeff =
+      (1.0f - std::tan(omega / 2.0f)) / (1.0f + std::tan(omega / 2.0f));
+
+  float output = coeff * (input - state) + state;
+  state = coeff * (output - input) + input;
+
+  // 元信号との50%ブレンド
+  return input * 0.5f + output * 0.5f;
+}
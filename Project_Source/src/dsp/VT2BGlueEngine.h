@@ -0,0 +1,493 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Glue DSP Engine
+
+    プラグイン（AudioProcessor / APVTS / Editor）から切り離した信号処理本体。
+    ベンチマークや他ホストへの組み込みから直接呼び出せる。
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "VT2BAlignedBuffer.h"
+#include "VT2BCoefficients.h"
+#include "VT2BConstants.h"
+#include "VT2BKernels.h"
+#include "VT2BOversampler.h"
+#include "VT2BSaturationADAA.h"
+#include "VT2BShapeTable.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+//==============================================================================
+/**
+ * VT-2B Black Glue Engine
+ *
+ * サチュレーション → 倍音生成 → トランジェント整形 → ゲイン補償 → Dry/Wet
+ * の信号チェーンをブロック単位で処理する。チャンネルごとの状態は内部に保持。
+ *
+ * ホストのブロックは kSubBlockSize 以下のサブブロックに分け、サブブロックごとに
+ * ステージ単位（ステージ内で全サンプル → 次のステージ）で処理する。作業バッファは
+ * L1 に収まり、無記憶ステージは実行時に選択したSIMDカーネル（VT2BKernels）または
+ * 自動ベクトル化できる単純ループで回す。シリアルに残るのはエンベロープの再帰のみ。
+ * 係数は VT2BCoefficientEngine がサブブロック単位で用意する。
+ *
+ * オーバーサンプリング有効時は非線形ステージ（サチュレーション + 倍音）のみを
+ * 高レートで処理し、Dry 側はレイテンシ分遅らせてから Wet と混ぜる。
+ * ADAA（VT2BSaturationADAA）はオーバーサンプリングの代わりにも併用にも使える。
+ *
+ * サブブロックごとに出力と再帰状態（エンベロープ）が有限かを確かめ、NaN / Inf が
+ * 出たチャンネルは出力を 0 に置き換えて状態を消す（getNumNonFiniteEvents()）。
+ *
+ * 呼び出し側でデノーマル対策（FTZ/DAZ）を行うこと。
+ */
+class VT2BGlueEngine {
+public:
+  //==============================================================================
+  /** サブブロック長（作業バッファ・係数列の長さ） */
+  static constexpr int kSubBlockSize = 64;
+
+  /** 最大チャンネル数（9.1.6 まで） */
+  static constexpr int kMaxChannels = 16;
+
+  //==============================================================================
+  VT2BGlueEngine() = default;
+
+  /**
+   * 再生準備
+   * 状態とスムーザーを初期化する。オーディオスレッド外で呼ぶこと。
+   * numChannels は kMaxChannels まで（超えた分のチャンネルは処理しない）。
+   */
+  void prepare(double sampleRate, int maximumBlockSize, int numChannels);
+
+  /** エンベロープ等の内部状態をクリア */
+  void reset();
+
+  //==============================================================================
+  /** Drive (0.0 - 10.0) の目標値。次の process() からスムージングされる */
+  void setDrive(float newDrive);
+
+  /** Mix (0.0 - 1.0) の目標値 */
+  void setMix(float newMix);
+
+  //==============================================================================
+  /**
+   * インプレース処理
+   * numChannels は prepare() で指定したチャンネル数以下であること。
+   */
+  void process(float *const *channels, int numChannels, int numSamples);
+
+  /**
+   * アウトオブプレース処理
+   * inputs と outputs は同じバッファを指してもよい。
+   */
+  void process(const float *const *inputs, float *const *outputs,
+               int numChannels, int numSamples);
+
+  /**
+   * 倍精度バッファの処理（Dry 経路のみ double のまま保つ）
+   * Dry 経路（遅延・ミックス）は double のまま扱い、Mix 0% では入力がそのまま
+   * 出る。Wet 系（シェイプ・オーバーサンプラー・ADAA・エンベロープ）は
+   * サブブロック単位で float に変換し、float 版と同じカーネルで処理する。
+   */
+  void process(double *const *channels, int numChannels, int numSamples);
+  void process(const double *const *inputs, double *const *outputs,
+               int numChannels, int numSamples);
+
+  //==============================================================================
+  /**
+   * 使用するSIMDレベルを指定（テスト・ベンチマーク用）
+   * 実行できないレベルは利用可能な下位レベルに落とされる。
+   */
+  void setSimdLevel(VT2BSimdLevel level);
+  VT2BSimdLevel getSimdLevel() const { return kernels->level; }
+
+  /**
+   * サチュレーションカーブの評価精度
+   * Reference は std::pow（スカラー）で、Fast との聴感差の検証に使う。
+   */
+  void setCurvePrecision(VT2BCurvePrecision precision);
+  VT2BCurvePrecision getCurvePrecision() const { return curvePrecision; }
+
+  /**
+   * オーバーサンプリング設定（factorLog2: 0 = 1x, 1 = 2x, 2 = 4x, 3 = 8x）
+   * 次の prepare() で反映される。オーディオスレッド外で呼ぶこと。
+   */
+  void setOversampling(int factorLog2, VT2BOversamplingFilter filterType);
+  int getOversamplingFactor() const { return oversampler.getFactor(); }
+  VT2BOversamplingFilter getOversamplingFilter() const {
+    return oversamplingFilter;
+  }
+
+  /**
+   * Drive 固定時に伝達関数表（VT2BShapeTable）で無記憶ステージを評価するか
+   * 表引きが速いカーネル（スカラー Fast）でのみ使う。表の作り直し中・
+   * ランプ中・ADAA 使用時は解析評価になる。
+   */
+  void setShapeTableEnabled(bool shouldUseTable) {
+    shapeTableEnabled = shouldUseTable;
+  }
+  bool isShapeTableEnabled() const { return shapeTableEnabled; }
+
+  /** 現在の表の誤差上限（絶対値、プリゲイン後のサチュレーション出力に対して） */
+  float getShapeTableErrorBound() const {
+    return shapeTable.getErrorBound();
+  }
+
+  /**
+   * サチュレーション段の ADAA（オーバーサンプリングより安価な折り返し対策）
+   * 次の prepare() で反映される。オーディオスレッド外で呼ぶこと。
+   */
+  void setAntialiasing(VT2BAntialiasing mode);
+  VT2BAntialiasing getAntialiasing() const { return antialiasing; }
+
+  /**
+   * トランジェント検出のチャンネル間リンク
+   * リンク時は 1 本のエンベロープで全チャンネルに同じ抑制をかける。
+   * オーディオスレッドから呼んでよい（次の process() から反映、状態は引き継ぐ）。
+   */
+  void setEnvelopeLink(VT2BEnvelopeLink link);
+  VT2BEnvelopeLink getEnvelopeLink() const { return envelopeLink; }
+
+  /**
+   * 処理全体のレイテンシ（ベースレートのサンプル数、prepare 後に有効）
+   * Dry 側もこの値だけ遅延させて Wet と揃えている。
+   */
+  int getLatencyInSamples() const { return latencySamples; }
+
+  /**
+   * テール長（秒）: 入力が無音になってからアイドルに入るまでの最長時間
+   * エンベロープが 0 dBFS から kIdleEnvelopeLevel まで減衰する時間に、
+   * フィルタの整定分を加えたもの。prepare 後に有効。
+   */
+  double getTailLengthSeconds() const;
+
+  /** 無音が続き、処理を止めているか */
+  bool isIdle() const { return idle; }
+
+  /**
+   * バイパス
+   * 切り替えは kBypassFadeSeconds でクロスフェードする。バイパス中は
+   * レイテンシを揃えた Dry を出すだけで DSP は回さず、直近の入力だけ残して
+   * 戻るときにエンベロープとシェイプ段の状態を慣らしてから処理を再開する。
+   * オーディオスレッドから呼んでよい（次の process() から反映）。
+   */
+  void setBypassed(bool shouldBypass) { bypassed = shouldBypass; }
+  bool isBypassed() const { return bypassed; }
+
+  /**
+   * サブブロックを固定の量子（サブブロック長）の格子に揃えるか（既定: 無効）
+   * 有効にすると、ホストの呼び出しの区切りではなく通算のサンプル位置で
+   * サブブロックを切り、ブロック単位の判定（アイドルへの移行）は量子の終わりで
+   * だけ行う。数サンプルずつ呼ばれても判定の位置と回数はホストのブロック長に
+   * よらない。入力を溜めないのでレイテンシは増えない。
+   */
+  void setQuantumAligned(bool shouldAlign) {
+    quantumAligned = shouldAlign;
+    quantumPosition = 0;
+  }
+  bool isQuantumAligned() const { return quantumAligned; }
+
+  /**
+   * トランジェント整形のゲインリダクションを記録するか（メーター用、既定: 無効）
+   * 有効時はサブブロックの終わりのエンベロープから抑制量を求め、最も深い値を
+   * takeGainReduction() まで保持する。オーディオスレッドから呼んでよい。
+   */
+  void setGainReductionMetering(bool shouldMeter) {
+    gainReductionMetering = shouldMeter;
+  }
+
+  /** 前回以降で最も深いゲインリダクション（リニア、1 = 抑制なし）を返して戻す */
+  float takeGainReduction() {
+    const float gain = minimumTransientGain;
+    minimumTransientGain = 1.0f;
+    return gain;
+  }
+
+  /**
+   * NaN / Inf から復帰した回数（チャンネル・サブブロックごとに 1、構築以降の通算）
+   * 診断用。どのスレッドから読んでもよい。
+   */
+  uint64_t getNumNonFiniteEvents() const {
+    return nonFiniteEvents.load(std::memory_order_relaxed);
+  }
+
+  //==============================================================================
+  double getSampleRate() const { return currentSampleRate; }
+  int getNumChannels() const { return preparedChannels; }
+
+private:
+  //==============================================================================
+  double currentSampleRate = 44100.0;
+  int subBlockSize = 0; // min(prepare 時の最大ブロック長, kSubBlockSize)
+
+  // 量子の格子に揃える場合の、現在の量子内の位置
+  bool quantumAligned = false;
+  int quantumPosition = 0;
+  int preparedChannels = 0; // prepare 時のチャンネル数（kMaxChannels 以下）
+
+  // チャンネルごとのDSP状態（チャンネル順に並べ、SIMD レーンで読み書きする）
+  // 領域は paddedChannels 分（端数のレーンは計算されるが使わない）
+  int paddedChannels = 0;
+  VT2BAlignedBuffer envelopeState; // エンベロープフォロワー（トランジェント検出用）
+  VT2BAlignedBuffer allpassState;  // オールパスフィルタ状態
+
+  // カーネル（構築時に実行環境で最速のものを選択）
+  VT2BSimdLevel simdLevel = VT2BCpuFeatures::getBestSimdLevel();
+  VT2BCurvePrecision curvePrecision = VT2BSaturationCurve::kDefaultPrecision;
+  const VT2BKernelTable *kernels = &VT2BKernels::getBest();
+
+  // サブブロック作業バッファ（prepareで確保、オーディオスレッドでは確保しない）
+  // チャンネル c の領域は [c * scratchStride, c * scratchStride + subBlockSize)
+  static constexpr int kScratchAlignment =
+      (int)(VT2BAlignedBuffer::kAlignment / sizeof(float));
+  int scratchStride = 0;
+  VT2BAlignedBuffer wetBuffer;
+  VT2BAlignedBuffer envelopeBuffer;
+  VT2BAlignedBuffer wetInputBuffer; // 倍精度入力を float にしたもの
+
+  float *getWet(int channel) {
+    return wetBuffer.get() + channel * scratchStride;
+  }
+  float *getEnvelope(int channel) {
+    return envelopeBuffer.get() + channel * scratchStride;
+  }
+
+  /** Wet 系に渡す入力（float はそのまま、double は変換して作業バッファへ） */
+  const float *getWetInput(int, const float *dry, int) { return dry; }
+  const float *getWetInput(int channel, const double *dry, int numSamples);
+
+  // オーバーサンプリング
+  int oversamplingFactorLog2 = 0;
+  VT2BOversamplingFilter oversamplingFilter =
+      VT2BOversamplingFilter::MinimumPhase;
+  VT2BOversampler oversampler;
+  VT2BAlignedBuffer oversampledBuffer;
+
+  // 高レート用に展開した係数列（ランプ中のみ使用）
+  VT2BControlBlock oversampledControl;
+  VT2BAlignedBuffer oversampledNormalizedDrive;
+  VT2BAlignedBuffer oversampledPreDriveGain;
+  VT2BAlignedBuffer oversampledSaturationK;
+
+  // Drive ごとの伝達関数表（ブロック単位で償却して作り直す）
+  bool shapeTableEnabled = true;
+  VT2BShapeTable shapeTable;
+  const VT2BShapeLookup *activeLookup = nullptr;
+
+  // ADAA（サチュレーション段の代替評価）
+  VT2BAntialiasing antialiasing = VT2BAntialiasing::Off;
+  VT2BSaturationADAA saturationADAA;
+
+  // トランジェント検出のリンク（リンク時の状態は envelopeState[0]）
+  VT2BEnvelopeLink envelopeLink = VT2BEnvelopeLink::Independent;
+
+  bool isEnvelopeLinked() const {
+    return envelopeLink != VT2BEnvelopeLink::Independent &&
+           preparedChannels > 1;
+  }
+
+  // レイテンシ補償用の Dry 遅延（倍精度入力の精度を保つため double で持つ）
+  int latencySamples = 0;
+  VT2BAlignedBuffer delayedDryBuffer;
+  VT2BAlignedArray<double> delayedDryBufferDouble;
+  std::vector<std::vector<double>> dryDelayLines;
+  std::vector<int> dryDelayPositions;
+
+  float *getDelayedDry(const float *) { return delayedDryBuffer.get(); }
+  double *getDelayedDry(const double *) {
+    return delayedDryBufferDouble.get();
+  }
+
+  // スムージングと係数
+  VT2BCoefficientEngine coefficients;
+
+  // Mix 0% / バイパスの間 Wet 系を止めているか
+  bool wetChainSuspended = false;
+
+  // バイパスで止めていた（エンベロープも再開時に流し直す）
+  bool envelopeSuspended = false;
+
+  // バイパスのクロスフェード（processedGain: 1 = 処理音、0 = バイパス）
+  bool bypassed = false;
+  float processedGain = 1.0f;
+  float bypassFadeStep = 0.0f; // 1 サンプルあたりの変化量
+  bool bypassFading = false;   // このサブブロックでフェード中か
+  VT2BAlignedBuffer bypassFadeRamp;
+
+  // Wet 系を止めている間の直近の入力（再開時に流し直す）
+  static constexpr int kWarmupLength = 2 * kSubBlockSize;
+  VT2BAlignedBuffer dryHistoryBuffer;
+  int suspendedLength = 0; // 止めていたサンプル数（kWarmupLength 超は区別しない）
+  VT2BDriveCoefficients suspendedDrive;
+
+  float *getDryHistory(int channel) {
+    return dryHistoryBuffer.get() + channel * kWarmupLength;
+  }
+
+  //==============================================================================
+  // DSP処理関数
+
+  /** ブロックをサブブロックに分けて処理（SampleType は float / double） */
+  template <typename SampleType>
+  void processBlock(const SampleType *const *inputs,
+                    SampleType *const *outputs, int numChannels,
+                    int numSamples);
+
+  /**
+   * バイパスのフェードを numSamples 進め、フェード中なら bypassFadeRamp に
+   * 処理音のゲインを書く。完全にバイパスしているときは false。
+   */
+  bool advanceBypassFade(int numSamples);
+
+  /** バイパス中: レイテンシを揃えた Dry を出し、直近の入力だけ残す */
+  template <typename SampleType>
+  void processBypassed(const SampleType *const *inputs,
+                       SampleType *const *outputs, int numChannels,
+                       int startSample, const VT2BControlBlock &control);
+
+  /** output = dry + (output - dry) * bypassFadeRamp（処理音とバイパス音の間） */
+  template <typename SampleType>
+  void applyBypassFade(const SampleType *dry, SampleType *output,
+                       int numSamples) const;
+
+  /** subBlockSize 以下の区間を処理（control はこの区間の係数） */
+  template <typename SampleType>
+  void processSubBlock(const SampleType *const *inputs,
+                       SampleType *const *outputs, int numChannels,
+                       int startSample, const VT2BControlBlock &control);
+
+  /**
+   * VT2BKernelTable::processShortBlock で全段をまとめて処理できるか
+   * （短いブロックで、段ごとの経路にしかない処理が要らないとき）
+   */
+  bool canProcessShortBlock(int numSamples) const;
+
+  //==============================================================================
+  // 無音検出
+  // 入力が無音のまま整定時間が過ぎ、出力とエンベロープも落ちたら状態を
+  // 消してアイドルに入る。アイドル中は入力の走査だけ行い無音を書く。
+  // 状態はしきい値以下しか残っていないので、信号が戻ればそのまま再開できる。
+  bool idle = false;
+  int silentSamples = 0;   // 連続した無音入力のサンプル数
+  int idleSettleLength = 0; // アイドルに入るまでに必要な無音の長さ
+
+  bool isSilent(const float *channel, int numSamples) const {
+    return kernels->isSilent(channel, numSamples,
+                             VT2BConstants::kSilenceThreshold);
+  }
+  bool isSilent(const double *channel, int numSamples) const;
+
+  // メーター用のゲインリダクション（有効時のみ更新）
+  bool gainReductionMetering = false;
+  float minimumTransientGain = 1.0f;
+
+  /** 処理後の区間のエンベロープからゲインリダクションを記録する */
+  void meterGainReduction(const VT2BControlBlock &control);
+
+  template <typename SampleType>
+  bool isSilent(const SampleType *const *channels, int numChannels,
+                int startSample, int numSamples) const;
+
+  //==============================================================================
+  // 非有限値（NaN / Inf）からの復帰
+  // ホストが NaN / Inf を渡すとエンベロープの再帰やオーバーサンプラーのフィルタに
+  // 残り、以降ずっと出力が壊れる。入力は Wet / Dry を通って出力に出るので、出力と
+  // エンベロープの状態だけを確かめる（入力を別に走査しない）。
+  std::atomic<uint64_t> nonFiniteEvents{0};
+
+  /** 区間が有限か（短い区間と double はインラインのループ、ほかはカーネル） */
+  bool isFinite(const float *channel, int numSamples) const;
+  bool isFinite(const double *channel, int numSamples) const;
+
+  /**
+   * 処理後の区間とエンベロープの状態を確かめ、有限でないチャンネルは出力の
+   * NaN / Inf を 0 にして recoverChannel() する
+   */
+  template <typename SampleType>
+  void guardNonFinite(SampleType *const *outputs, int numChannels,
+                      int startSample, int numSamples);
+
+  /**
+   * 1 チャンネル分の状態を消す（エンベロープ・オーバーサンプラー・ADAA）
+   * Dry の遅延と再開用の履歴は有限でないサンプルだけ 0 にする
+   */
+  void recoverChannel(int channel);
+
+  /** 処理後の区間からアイドルに入れるか判定する */
+  template <typename SampleType>
+  void updateIdle(SampleType *const *outputs, int numChannels,
+                  int startSample, bool inputSilent,
+                  const VT2BControlBlock &control);
+
+  /**
+   * Mix 0%（静的）: Dry をレイテンシ分遅らせて出力し、Wet 系は止める
+   * エンベロープだけは処理レートのシェイプで追従させ続ける。
+   */
+  template <typename SampleType>
+  void processFullyDry(const SampleType *const *inputs,
+                       SampleType *const *outputs, int numChannels,
+                       int startSample, const VT2BControlBlock &control);
+
+  /** シェイプ段（オーバーサンプラー / ADAA）が内部状態を持つか */
+  bool hasShapeState() const {
+    return oversampler.getFactor() > 1 ||
+           antialiasing != VT2BAntialiasing::Off;
+  }
+
+  /** Wet 系を止めている間の入力を直近 kWarmupLength サンプル分だけ残す */
+  void rememberDry(int channel, const float *input, int numSamples);
+
+  /**
+   * Mix 0% / バイパスから戻るとき、止めていた間の入力をシェイプ段に流し直して
+   * 状態を追いつかせる（Mix 0% ではエンベロープは止めている間も追従済み、
+   * バイパスからはエンベロープにも流し直す）
+   */
+  void resumeWetChain();
+
+  /** 非線形ステージ（1. サチュレーション + 2. 倍音）を処理レートのまま評価 */
+  void processShape(int channel, const float *input, float *wet,
+                    const VT2BControlBlock &control);
+
+  /**
+   * 非線形ステージを高レートで処理
+   * oversampledBlock は getOversampledControl() の結果
+   */
+  void processShapeOversampled(int channel, const float *dry, float *wet,
+                               const VT2BControlBlock &oversampledBlock);
+
+  /** ランプ中の係数列を高レート用に展開（0次ホールド） */
+  const VT2BControlBlock &
+  getOversampledControl(const VT2BControlBlock &control);
+
+  /** Dry 信号をレイテンシ分遅延させる（output は input と同じでもよい） */
+  template <typename SampleType>
+  void delayDry(int channel, const SampleType *input, SampleType *output,
+                int numSamples);
+
+  /** 5. ゲイン補償 + Dry/Wet ミックス（float はカーネル、double は倍精度で） */
+  void makeupAndMix(const float *dry, const float *wet, float *output,
+                    const VT2BControlBlock &control) {
+    kernels->makeupAndMix(dry, wet, output, control);
+  }
+  void makeupAndMix(const double *dry, const float *wet, double *output,
+                    const VT2BControlBlock &control);
+
+  /**
+   * トランジェント整形のエンベロープフォロワー
+   * 全チャンネルの Wet から各サンプル時点のエンベロープを書き出す
+   * （VT2BKernelTable::followEnvelopes、チャンネルを SIMD レーンに載せる）。
+   * ゲインの適用は VT2BKernelTable::transientGain で行う。
+   * リンク時は 1 本だけ計算し、getEnvelope(0) を全チャンネルで使う。
+   */
+  void followEnvelopes(int numChannels, int numSamples);
+
+  /**
+   * 位相安定化オールパス
+   * 低域の位相を安定させステレオ像を維持
+   */
+  float processAllpass(float input, float &state) const;
+};
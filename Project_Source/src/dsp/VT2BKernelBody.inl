@@ -0,0 +1,444 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Vectorized DSP Kernel Body
+
+    命令セット別の翻訳単位から namespace 内でインクルードされる共通本体。
+    インクルード前に VT2BKernelScalar.h を読み込み、以下を定義しておくこと:
+
+      VT2B_KERNEL_TARGET  関数に付与する target 属性（なければ空）
+      struct Ops          レジスタ型 Reg と width、load/store/set1/add/sub/
+                          mul/div/sqrt/abs/neg/min/max/selectNonNegative、
+                          表引き用の Index 型と truncate/gather/anyNegative
+
+    演算順序はスカラー版と揃えてあり、|x|^2.5 は常に Fast 精度
+    （x² · √x、VT2BSaturationCurve::evaluateFast）で評価する。
+  ==============================================================================
+*/
+
+// 端数サンプルはスカラー版（SIMD本体と同じ演算順）
+static inline float shapeSample(float input, float normalizedDrive,
+                                float preDriveGain, float k) {
+  return VT2BKernelScalar::shapeSample<VT2BCurvePrecision::Fast>(
+      input, normalizedDrive, preDriveGain, k);
+}
+
+using VT2BKernelScalar::transientGainSample;
+
+static inline VT2B_KERNEL_TARGET Ops::Reg
+shapeVector(Ops::Reg input, Ops::Reg normalizedDrive, Ops::Reg preDriveGain,
+            Ops::Reg k) {
+  using Reg = Ops::Reg;
+
+  Reg x = Ops::mul(input, preDriveGain);
+  Reg absX = Ops::abs(x);
+
+  // |x|^2.5 = x² · √x（VT2BSaturationCurve::evaluateFast と同じ演算順）
+  Reg saturation = Ops::mul(Ops::mul(absX, absX), Ops::sqrt(absX));
+  Reg saturated =
+      Ops::div(x, Ops::add(Ops::set1(1.0f), Ops::mul(k, saturation)));
+
+  Reg x2 = Ops::mul(x, x);
+  Reg harmonic2 =
+      Ops::mul(Ops::mul(x2, Ops::set1(VT2BConstants::kHarmonic2ndAmount)),
+               normalizedDrive);
+  Reg harmonic3 = Ops::mul(
+      Ops::mul(Ops::mul(x2, x), Ops::set1(VT2BConstants::kHarmonic3rdAmount)),
+      normalizedDrive);
+  harmonic2 = Ops::selectNonNegative(x, harmonic2, Ops::neg(harmonic2));
+
+  return Ops::add(saturated, Ops::add(harmonic2, harmonic3));
+}
+
+// 伝達関数表の表引き（位置は [0, lastCell] に丸めるので NaN でも範囲内）
+static inline VT2B_KERNEL_TARGET Ops::Reg
+lookupVector(Ops::Reg input, const VT2BShapeLookup &lookup, Ops::Reg scale,
+             Ops::Reg offset, Ops::Reg lastCell) {
+  Ops::Reg position = Ops::add(Ops::mul(input, scale), offset);
+  position = Ops::min(Ops::max(position, Ops::set1(0.0f)), lastCell);
+
+  const auto index = Ops::truncate(position);
+  return Ops::add(Ops::mul(Ops::gather(lookup.slope, index), input),
+                  Ops::gather(lookup.intercept, index));
+}
+
+// しきい値以下と NaN は excess = 0（スカラー版と同じ）
+static inline VT2B_KERNEL_TARGET Ops::Reg
+transientGainVector(Ops::Reg wet, Ops::Reg envelope, Ops::Reg amount) {
+  using Reg = Ops::Reg;
+
+  Reg excess = Ops::div(
+      Ops::sub(envelope, Ops::set1(VT2BConstants::kTransientThreshold)),
+      Ops::set1(VT2BConstants::kTransientKnee));
+  excess = Ops::selectNonNegative(excess, excess, Ops::set1(0.0f));
+
+  Reg reduction = Ops::mul(Ops::min(excess, Ops::set1(1.0f)), amount);
+  return Ops::mul(wet, Ops::sub(Ops::set1(1.0f), reduction));
+}
+
+static inline VT2B_KERNEL_TARGET Ops::Reg
+makeupAndMixVector(Ops::Reg dry, Ops::Reg wet, Ops::Reg makeupGain,
+                   Ops::Reg mix) {
+  return Ops::add(Ops::mul(dry, Ops::sub(Ops::set1(1.0f), mix)),
+                  Ops::mul(Ops::mul(wet, makeupGain), mix));
+}
+
+//==============================================================================
+// 係数の供給元
+// ブロック単位で静的 / ランプ中を選んでループをインスタンス化し、
+// ループ内には分岐を残さない。
+
+// 静的ブロック: 全サンプル同じ値（レジスタに保持）
+struct StaticParam {
+  float value;
+  Ops::Reg vector;
+
+  VT2B_KERNEL_TARGET explicit StaticParam(float v)
+      : value(v), vector(Ops::set1(v)) {}
+  VT2B_KERNEL_TARGET Ops::Reg load(int) const { return vector; }
+  float operator[](int) const { return value; }
+};
+
+// ランプ中: サンプルごとの係数列
+struct RampParam {
+  const float *values;
+
+  VT2B_KERNEL_TARGET explicit RampParam(const float *v) : values(v) {}
+  VT2B_KERNEL_TARGET Ops::Reg load(int i) const {
+    return Ops::load(values + i);
+  }
+  float operator[](int i) const { return values[i]; }
+};
+
+//==============================================================================
+template <class Param>
+static VT2B_KERNEL_TARGET void
+shapeBlock(const float *input, float *wet, int numSamples,
+           const Param &normalizedDrive, const Param &preDriveGain,
+           const Param &k) {
+  int i = 0;
+
+  for (; i + Ops::width <= numSamples; i += Ops::width)
+    Ops::store(wet + i, shapeVector(Ops::load(input + i),
+                                    normalizedDrive.load(i),
+                                    preDriveGain.load(i), k.load(i)));
+
+  for (; i < numSamples; ++i)
+    wet[i] = shapeSample(input[i], normalizedDrive[i], preDriveGain[i], k[i]);
+}
+
+static VT2B_KERNEL_TARGET void shape(const float *input, float *wet,
+                                     const VT2BControlBlock &control) {
+  if (control.ramping) {
+    shapeBlock(input, wet, control.numSamples,
+               RampParam(control.normalizedDrive),
+               RampParam(control.preDriveGain), RampParam(control.saturationK));
+  } else {
+    const auto &c = control.drive;
+    shapeBlock(input, wet, control.numSamples, StaticParam(c.normalizedDrive),
+               StaticParam(c.preDriveGain), StaticParam(c.saturationK));
+  }
+}
+
+//==============================================================================
+// エンベロープフォロワー
+
+// 残りチャンネルが少ないときはスカラー版（複数チャンネルの連鎖を重ねる）
+using VT2BKernelScalar::followEnvelopeGroup;
+
+// レーン版に回す最小チャンネル数（2 チャンネル以下はスカラー 2 本の方が速い。
+// gather と端数レーンの書き戻しのコストがサンプルごとにかかるため）
+constexpr int kMinEnvelopeLanes = 3;
+
+// Ops::width チャンネルを 1 本のレジスタで回す（numLanes 以降のレーンは捨てる）
+static VT2B_KERNEL_TARGET void
+followEnvelopeLanes(const float *wet, float *envelope, int stride, float *state,
+                    int numLanes, int numSamples, float attack, float release) {
+  float laneOffsets[Ops::width];
+  float lanes[Ops::width];
+
+  for (int j = 0; j < Ops::width; ++j)
+    laneOffsets[j] = (float)(j * stride);
+
+  const auto index = Ops::truncate(Ops::load(laneOffsets));
+  const auto attackVector = Ops::set1(attack);
+  const auto releaseVector = Ops::set1(release);
+  auto current = Ops::load(state);
+
+  for (int i = 0; i < numSamples; ++i) {
+    const auto absInput = Ops::abs(Ops::gather(wet + i, index));
+
+    // |x| > env なら attack（NaN はどちらでも env が NaN になるので区別しない）
+    const auto coeff = Ops::selectNonNegative(Ops::sub(current, absInput),
+                                              releaseVector, attackVector);
+    current = Ops::add(current, Ops::mul(coeff, Ops::sub(absInput, current)));
+
+    Ops::store(lanes, current);
+
+    for (int j = 0; j < numLanes; ++j)
+      envelope[j * stride + i] = lanes[j];
+  }
+
+  Ops::store(state, current);
+}
+
+static VT2B_KERNEL_TARGET void
+followEnvelopes(const float *wet, float *envelope, int stride, float *state,
+                int numChannels, int numSamples, float attack, float release) {
+  int channel = 0;
+
+  for (; numChannels - channel >= kMinEnvelopeLanes; channel += Ops::width) {
+    const int remaining = numChannels - channel;
+    followEnvelopeLanes(wet + channel * stride, envelope + channel * stride,
+                        stride, state + channel,
+                        remaining < Ops::width ? remaining : Ops::width,
+                        numSamples, attack, release);
+  }
+
+  for (; channel + 2 <= numChannels; channel += 2)
+    followEnvelopeGroup<2>(wet + channel * stride, envelope + channel * stride,
+                           stride, state + channel, numSamples, attack,
+                           release);
+
+  for (; channel < numChannels; ++channel)
+    followEnvelopeGroup<1>(wet + channel * stride, envelope + channel * stride,
+                           stride, state + channel, numSamples, attack,
+                           release);
+}
+
+// 検出値はサンプル方向にベクトル化し、再帰だけを直列に回す
+static VT2B_KERNEL_TARGET void
+followLinkedEnvelope(const float *wet, float *envelope, int stride,
+                     float *state, int numChannels, int numSamples,
+                     float attack, float release, VT2BEnvelopeLink link) {
+  const bool average = link == VT2BEnvelopeLink::Average;
+  const float scale = 1.0f / (float)numChannels;
+  int i = 0;
+
+  for (; i + Ops::width <= numSamples; i += Ops::width) {
+    auto detector = Ops::abs(Ops::load(wet + i));
+
+    for (int channel = 1; channel < numChannels; ++channel) {
+      const auto absInput = Ops::abs(Ops::load(wet + channel * stride + i));
+      detector = average ? Ops::add(detector, absInput)
+                         : Ops::max(detector, absInput);
+    }
+
+    if (average)
+      detector = Ops::mul(detector, Ops::set1(scale));
+
+    Ops::store(envelope + i, detector);
+  }
+
+  for (; i < numSamples; ++i) {
+    float detector = std::abs(wet[i]);
+
+    for (int channel = 1; channel < numChannels; ++channel) {
+      const float absInput = std::abs(wet[channel * stride + i]);
+      detector = average ? detector + absInput
+                         : (absInput > detector ? absInput : detector);
+    }
+
+    envelope[i] = average ? detector * scale : detector;
+  }
+
+  // 再帰（env * (1 - c) + c * d の 2 候補の max、連鎖は乗算・加算・max のみ）
+  const float attackKeep = 1.0f - attack;
+  const float releaseKeep = 1.0f - release;
+  float current = state[0];
+
+  for (int j = 0; j < numSamples; ++j) {
+    const float detector = envelope[j];
+    const float attacked = current * attackKeep + attack * detector;
+    const float released = current * releaseKeep + release * detector;
+
+    current = attacked > released ? attacked : released;
+    envelope[j] = current;
+  }
+
+  state[0] = current;
+}
+
+//==============================================================================
+static VT2B_KERNEL_TARGET void shapeLookup(const float *input, float *wet,
+                                           const VT2BShapeLookup &lookup,
+                                           const VT2BControlBlock &control) {
+  const int numSamples = control.numSamples;
+  const auto &c = control.drive;
+  int i = 0;
+
+  const auto scale = Ops::set1(lookup.scale);
+  const auto offset = Ops::set1(lookup.offset);
+  const auto lastCell = Ops::set1(lookup.lastCell);
+  const auto range = Ops::set1(lookup.range);
+
+  for (; i + Ops::width <= numSamples; i += Ops::width) {
+    const auto x = Ops::load(input + i);
+    auto y = lookupVector(x, lookup, scale, offset, lastCell);
+
+    // 表の範囲外（+6 dBFS 超）のレーンだけ解析値に差し替える
+    const auto margin = Ops::sub(range, Ops::abs(x));
+
+    if (Ops::anyNegative(margin))
+      y = Ops::selectNonNegative(
+          margin, y,
+          shapeVector(x, Ops::set1(c.normalizedDrive),
+                      Ops::set1(c.preDriveGain), Ops::set1(c.saturationK)));
+
+    Ops::store(wet + i, y);
+  }
+
+  for (; i < numSamples; ++i) {
+    if (std::abs(input[i]) <= lookup.range)
+      wet[i] = lookup.evaluate(input[i]);
+    else
+      wet[i] = shapeSample(input[i], c.normalizedDrive, c.preDriveGain,
+                           c.saturationK);
+  }
+}
+
+template <class Param>
+static VT2B_KERNEL_TARGET void transientGainBlock(float *wet,
+                                                  const float *envelope,
+                                                  int numSamples,
+                                                  const Param &amount) {
+  int i = 0;
+
+  for (; i + Ops::width <= numSamples; i += Ops::width)
+    Ops::store(wet + i, transientGainVector(Ops::load(wet + i),
+                                            Ops::load(envelope + i),
+                                            amount.load(i)));
+
+  for (; i < numSamples; ++i)
+    wet[i] = transientGainSample(wet[i], envelope[i], amount[i]);
+}
+
+static VT2B_KERNEL_TARGET void transientGain(float *wet, const float *envelope,
+                                             const VT2BControlBlock &control) {
+  if (control.ramping)
+    transientGainBlock(wet, envelope, control.numSamples,
+                       RampParam(control.transientAmount));
+  else
+    transientGainBlock(wet, envelope, control.numSamples,
+                       StaticParam(control.drive.transientAmount));
+}
+
+template <class Param>
+static VT2B_KERNEL_TARGET void
+makeupAndMixBlock(const float *dry, const float *wet, float *output,
+                  int numSamples, const Param &makeupGain, const Param &mix) {
+  int i = 0;
+
+  for (; i + Ops::width <= numSamples; i += Ops::width)
+    Ops::store(output + i,
+               makeupAndMixVector(Ops::load(dry + i), Ops::load(wet + i),
+                                  makeupGain.load(i), mix.load(i)));
+
+  for (; i < numSamples; ++i)
+    output[i] = dry[i] * (1.0f - mix[i]) + wet[i] * makeupGain[i] * mix[i];
+}
+
+// Mix 100%: Dry を読まない（dry * 0 + y と同値。y = -0 のときのみ符号が異なる）
+static VT2B_KERNEL_TARGET void makeupFullyWet(const float *wet, float *output,
+                                              int numSamples,
+                                              float makeupGain) {
+  const auto makeupGainVector = Ops::set1(makeupGain);
+  int i = 0;
+
+  for (; i + Ops::width <= numSamples; i += Ops::width)
+    Ops::store(output + i, Ops::mul(Ops::load(wet + i), makeupGainVector));
+
+  for (; i < numSamples; ++i)
+    output[i] = wet[i] * makeupGain;
+}
+
+static VT2B_KERNEL_TARGET void makeupAndMix(const float *dry, const float *wet,
+                                            float *output,
+                                            const VT2BControlBlock &control) {
+  if (control.ramping)
+    makeupAndMixBlock(dry, wet, output, control.numSamples,
+                      RampParam(control.makeupGain),
+                      RampParam(control.mixRamp));
+  else if (control.mix == 1.0f)
+    makeupFullyWet(wet, output, control.numSamples, control.drive.makeupGain);
+  else
+    makeupAndMixBlock(dry, wet, output, control.numSamples,
+                      StaticParam(control.drive.makeupGain),
+                      StaticParam(control.mix));
+}
+
+// しきい値を超えたレーン（と NaN）は -1 を残す
+static VT2B_KERNEL_TARGET bool isSilent(const float *input, int numSamples,
+                                        float threshold) {
+  const auto thresholdVector = Ops::set1(threshold);
+  const auto zero = Ops::set1(0.0f);
+  const auto loud = Ops::set1(-1.0f);
+  auto flags = zero;
+  int i = 0;
+
+  for (; i + Ops::width <= numSamples; i += Ops::width) {
+    const auto margin =
+        Ops::sub(thresholdVector, Ops::abs(Ops::load(input + i)));
+    flags = Ops::min(flags, Ops::selectNonNegative(margin, zero, loud));
+  }
+
+  if (Ops::anyNegative(flags))
+    return false;
+
+  for (; i < numSamples; ++i)
+    if (!(std::abs(input[i]) <= threshold))
+      return false;
+
+  return true;
+}
+
+// x - x は有限なら 0、NaN / ±Inf なら NaN（NaN のレーンは -1 を残す）
+static VT2B_KERNEL_TARGET bool isFinite(const float *input, int numSamples) {
+  const auto zero = Ops::set1(0.0f);
+  const auto nonFinite = Ops::set1(-1.0f);
+  auto flags = zero;
+  int i = 0;
+
+  for (; i + Ops::width <= numSamples; i += Ops::width) {
+    const auto x = Ops::load(input + i);
+    flags = Ops::min(flags,
+                     Ops::selectNonNegative(Ops::sub(x, x), zero, nonFinite));
+  }
+
+  if (Ops::anyNegative(flags))
+    return false;
+
+  for (; i < numSamples; ++i)
+    if (!(input[i] - input[i] == 0.0f))
+      return false;
+
+  return true;
+}
+
+//==============================================================================
+// 短いブロックはスカラー版をこの target 属性で展開する（この長さでは各段も
+// 端数ループしか回らないので、各段を個別に呼んだ場合とビット一致する）
+static VT2B_KERNEL_TARGET void
+processShortBlock(const float *const *inputs, float *const *outputs,
+                  int numChannels, int startSample, float *state,
+                  const VT2BShapeLookup *lookup,
+                  const VT2BControlBlock &control, float attack,
+                  float release) {
+  VT2BKernelScalar::processShortBlock<VT2BCurvePrecision::Fast>(
+      inputs, outputs, numChannels, startSample, state, lookup, control,
+      attack, release);
+}
+
+static const VT2BKernelTable kernelTable = {kernelLevel,
+                                            VT2BCurvePrecision::Fast,
+                                            false,
+                                            Ops::width,
+                                            shape,
+                                            shapeLookup,
+                                            followEnvelopes,
+                                            followLinkedEnvelope,
+                                            transientGain,
+                                            makeupAndMix,
+                                            isSilent,
+                                            isFinite,
+                                            processShortBlock};
@@ -0,0 +1,202 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Scalar Kernel Building Blocks
+
+    スカラー版（VT2BKernels.cpp）と命令セット別の本体（VT2BKernelBody.inl）が
+    共有するサンプル単位の処理。SIMD 版の端数サンプルもこれを使うので、
+    演算順序を変えるときは両方の結果が変わることに注意する。
+
+    関数は常に呼び出し側へ展開する（命令セット別の本体では、その target 属性
+    のもとでコンパイルされ、FMA 縮約の有無まで SIMD 版の各段と揃う）。
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "VT2BConstants.h"
+#include "VT2BKernels.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define VT2B_SCALAR_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define VT2B_SCALAR_INLINE __forceinline
+#else
+#define VT2B_SCALAR_INLINE inline
+#endif
+
+namespace VT2BKernelScalar {
+template <VT2BCurvePrecision precision>
+VT2B_SCALAR_INLINE float shapeSample(float input, float normalizedDrive,
+                                     float preDriveGain, float k) {
+  // 1. サチュレーション（密度増加）: f(x) = x / (1 + k * |x|^n)
+  float x = input * preDriveGain;
+  float saturation = VT2BSaturationCurve::evaluate<precision>(std::abs(x));
+
+  // 2. 倍音生成（偶数倍音は常に正、奇数倍音は符号を保持）
+  float harmonic2 = x * x * VT2BConstants::kHarmonic2ndAmount * normalizedDrive;
+  float harmonic3 =
+      x * x * x * VT2BConstants::kHarmonic3rdAmount * normalizedDrive;
+  harmonic2 = (x >= 0.0f) ? harmonic2 : -harmonic2;
+
+  return x / (1.0f + k * saturation) + (harmonic2 + harmonic3);
+}
+
+VT2B_SCALAR_INLINE float transientGainSample(float wet, float envelope,
+                                             float amount) {
+  // しきい値以下と NaN は excess = 0（従来の envelope > threshold 判定と同値）
+  float excess = (envelope - VT2BConstants::kTransientThreshold) /
+                 VT2BConstants::kTransientKnee;
+  excess = excess >= 0.0f ? excess : 0.0f;
+
+  float reduction = std::min(1.0f, excess) * amount;
+  return wet * (1.0f - reduction);
+}
+
+// 係数の供給元（ブロック単位で選び、ループ内に分岐を残さない）
+struct StaticParam {
+  float value;
+  float operator[](int) const { return value; }
+};
+
+struct RampParam {
+  const float *values;
+  float operator[](int i) const { return values[i]; }
+};
+
+// 1チャンネルの再帰は依存の連鎖でレイテンシ律速になるため、
+// 複数チャンネルを同じループで回して連鎖を重ねる
+template <int groupSize>
+VT2B_SCALAR_INLINE void followEnvelopeGroup(const float *wet, float *envelope,
+                                            int stride, float *state,
+                                            int numSamples, float attack,
+                                            float release) {
+  // 状態はローカルに持ち、ループ中のメモリ往復を避ける
+  std::array<float, (size_t)groupSize> current;
+
+  for (size_t j = 0; j < current.size(); ++j)
+    current[j] = state[j];
+
+  for (int i = 0; i < numSamples; ++i) {
+    for (size_t j = 0; j < current.size(); ++j) {
+      const int index = (int)j * stride + i;
+      const float absInput = std::abs(wet[index]);
+      const float coeff = absInput > current[j] ? attack : release;
+
+      current[j] = current[j] + coeff * (absInput - current[j]);
+      envelope[index] = current[j];
+    }
+  }
+
+  for (size_t j = 0; j < current.size(); ++j)
+    state[j] = current[j];
+}
+
+//==============================================================================
+// 短いブロック: 各段と同じ式をサンプルごとにまとめて回す（ビット一致）
+// 表引きの有無と Mix 100% はブロック単位で選び、ループ内に分岐を残さない
+
+template <class Param> struct ShortBlockParams {
+  Param normalizedDrive, preDriveGain, k, amount, makeupGain, mix;
+};
+
+template <VT2BCurvePrecision precision, bool hasLookup, bool fullyWet,
+          class Param>
+VT2B_SCALAR_INLINE void
+processShortChannel(const float *input, float *output, float *state,
+                    int numSamples, const VT2BShapeLookup *lookup,
+                    const ShortBlockParams<Param> &params, float attack,
+                    float release) {
+  float current = *state;
+
+  for (int i = 0; i < numSamples; ++i) {
+    const float dry = input[i];
+    float wet;
+
+    if (hasLookup && std::abs(dry) <= lookup->range)
+      wet = lookup->evaluate(dry);
+    else
+      wet = shapeSample<precision>(dry, params.normalizedDrive[i],
+                                   params.preDriveGain[i], params.k[i]);
+
+    const float absInput = std::abs(wet);
+    const float coeff = absInput > current ? attack : release;
+    current = current + coeff * (absInput - current);
+
+    wet = transientGainSample(wet, current, params.amount[i]);
+
+    if (fullyWet)
+      output[i] = wet * params.makeupGain[i];
+    else
+      output[i] = dry * (1.0f - params.mix[i]) +
+                  wet * params.makeupGain[i] * params.mix[i];
+  }
+
+  *state = current;
+}
+
+template <VT2BCurvePrecision precision, bool hasLookup, bool fullyWet,
+          class Param>
+VT2B_SCALAR_INLINE void
+processShortChannels(const float *const *inputs, float *const *outputs,
+                     int numChannels, int startSample, int numSamples,
+                     float *state, const VT2BShapeLookup *lookup,
+                     const ShortBlockParams<Param> &params, float attack,
+                     float release) {
+  for (int channel = 0; channel < numChannels; ++channel)
+    processShortChannel<precision, hasLookup, fullyWet>(
+        inputs[channel] + startSample, outputs[channel] + startSample,
+        state + channel, numSamples, lookup, params, attack, release);
+}
+
+/** VT2BKernelTable::processShortBlock（SIMD 版は本体の target 属性で包む） */
+template <VT2BCurvePrecision precision>
+VT2B_SCALAR_INLINE void
+processShortBlock(const float *const *inputs, float *const *outputs,
+                  int numChannels, int startSample, float *state,
+                  const VT2BShapeLookup *lookup,
+                  const VT2BControlBlock &control, float attack,
+                  float release) {
+  const int numSamples = control.numSamples;
+
+  // ランプ中は表引きも Mix 100% の省略もしない（各段と同じ）
+  if (control.ramping) {
+    const ShortBlockParams<RampParam> ramp = {
+        {control.normalizedDrive}, {control.preDriveGain},
+        {control.saturationK},     {control.transientAmount},
+        {control.makeupGain},      {control.mixRamp}};
+    processShortChannels<precision, false, false>(
+        inputs, outputs, numChannels, startSample, numSamples, state, nullptr,
+        ramp, attack, release);
+    return;
+  }
+
+  const auto &c = control.drive;
+  const ShortBlockParams<StaticParam> fixed = {
+      {c.normalizedDrive}, {c.preDriveGain}, {c.saturationK},
+      {c.transientAmount}, {c.makeupGain},   {control.mix}};
+  const bool fullyWet = control.mix == 1.0f;
+
+  if (lookup != nullptr && fullyWet)
+    processShortChannels<precision, true, true>(inputs, outputs, numChannels,
+                                                startSample, numSamples, state,
+                                                lookup, fixed, attack, release);
+  else if (lookup != nullptr)
+    processShortChannels<precision, true, false>(
+        inputs, outputs, numChannels, startSample, numSamples, state, lookup,
+        fixed, attack, release);
+  else if (fullyWet)
+    processShortChannels<precision, false, true>(
+        inputs, outputs, numChannels, startSample, numSamples, state, nullptr,
+        fixed, attack, release);
+  else
+    processShortChannels<precision, false, false>(
+        inputs, outputs, numChannels, startSample, numSamples, state, nullptr,
+        fixed, attack, release);
+}
+} // namespace VT2BKernelScalar
@@ -0,0 +1,269 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Scalar Kernel / Runtime Dispatch
+  ==============================================================================
+*/
+
+#include "VT2BKernels.h"
+#include "VT2BConstants.h"
+#include "VT2BKernelScalar.h"
+
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+// スカラー版（全環境で利用可能なフォールバック）
+// Reference 精度では従来処理とビット一致する
+namespace {
+using VT2BKernelScalar::followEnvelopeGroup;
+using VT2BKernelScalar::RampParam;
+using VT2BKernelScalar::shapeSample;
+using VT2BKernelScalar::StaticParam;
+using VT2BKernelScalar::transientGainSample;
+
+template <VT2BCurvePrecision precision, class Param>
+void shapeBlock(const float *input, float *wet, int numSamples,
+                const Param &normalizedDrive, const Param &preDriveGain,
+                const Param &k) {
+  for (int i = 0; i < numSamples; ++i)
+    wet[i] = shapeSample<precision>(input[i], normalizedDrive[i],
+                                    preDriveGain[i], k[i]);
+}
+
+template <VT2BCurvePrecision precision>
+void shapeScalar(const float *input, float *wet,
+                 const VT2BControlBlock &control) {
+  if (control.ramping) {
+    shapeBlock<precision>(input, wet, control.numSamples,
+                          RampParam{control.normalizedDrive},
+                          RampParam{control.preDriveGain},
+                          RampParam{control.saturationK});
+  } else {
+    const auto &c = control.drive;
+    shapeBlock<precision>(input, wet, control.numSamples,
+                          StaticParam{c.normalizedDrive},
+                          StaticParam{c.preDriveGain},
+                          StaticParam{c.saturationK});
+  }
+}
+
+template <VT2BCurvePrecision precision>
+void shapeLookupScalar(const float *input, float *wet,
+                       const VT2BShapeLookup &lookup,
+                       const VT2BControlBlock &control) {
+  const auto &c = control.drive;
+
+  for (int i = 0; i < control.numSamples; ++i) {
+    if (std::abs(input[i]) <= lookup.range)
+      wet[i] = lookup.evaluate(input[i]);
+    else
+      wet[i] = shapeSample<precision>(input[i], c.normalizedDrive,
+                                      c.preDriveGain, c.saturationK);
+  }
+}
+
+void followEnvelopesScalar(const float *wet, float *envelope, int stride,
+                           float *state, int numChannels, int numSamples,
+                           float attack, float release) {
+  int channel = 0;
+
+  for (; channel + 4 <= numChannels; channel += 4)
+    followEnvelopeGroup<4>(wet + channel * stride, envelope + channel * stride,
+                           stride, state + channel, numSamples, attack,
+                           release);
+
+  for (; channel + 2 <= numChannels; channel += 2)
+    followEnvelopeGroup<2>(wet + channel * stride, envelope + channel * stride,
+                           stride, state + channel, numSamples, attack,
+                           release);
+
+  for (; channel < numChannels; ++channel)
+    followEnvelopeGroup<1>(wet + channel * stride, envelope + channel * stride,
+                           stride, state + channel, numSamples, attack,
+                           release);
+}
+
+void followLinkedEnvelopeScalar(const float *wet, float *envelope, int stride,
+                                float *state, int numChannels, int numSamples,
+                                float attack, float release,
+                                VT2BEnvelopeLink link) {
+  // 検出値（全チャンネルの |wet| の max / 平均）
+  for (int i = 0; i < numSamples; ++i)
+    envelope[i] = std::abs(wet[i]);
+
+  for (int channel = 1; channel < numChannels; ++channel) {
+    const float *input = wet + channel * stride;
+
+    if (link == VT2BEnvelopeLink::Average)
+      for (int i = 0; i < numSamples; ++i)
+        envelope[i] += std::abs(input[i]);
+    else
+      for (int i = 0; i < numSamples; ++i)
+        envelope[i] = std::max(envelope[i], std::abs(input[i]));
+  }
+
+  if (link == VT2BEnvelopeLink::Average) {
+    const float scale = 1.0f / (float)numChannels;
+
+    for (int i = 0; i < numSamples; ++i)
+      envelope[i] *= scale;
+  }
+
+  // 再帰（env * (1 - c) + c * d の 2 候補の max、連鎖は乗算・加算・max のみ）
+  const float attackKeep = 1.0f - attack;
+  const float releaseKeep = 1.0f - release;
+  float current = state[0];
+
+  for (int i = 0; i < numSamples; ++i) {
+    const float detector = envelope[i];
+    current = std::max(current * attackKeep + attack * detector,
+                       current * releaseKeep + release * detector);
+    envelope[i] = current;
+  }
+
+  state[0] = current;
+}
+
+template <class Param>
+void transientGainBlock(float *wet, const float *envelope, int numSamples,
+                        const Param &amount) {
+  for (int i = 0; i < numSamples; ++i)
+    wet[i] = transientGainSample(wet[i], envelope[i], amount[i]);
+}
+
+void transientGainScalar(float *wet, const float *envelope,
+                         const VT2BControlBlock &control) {
+  if (control.ramping)
+    transientGainBlock(wet, envelope, control.numSamples,
+                       RampParam{control.transientAmount});
+  else
+    transientGainBlock(wet, envelope, control.numSamples,
+                       StaticParam{control.drive.transientAmount});
+}
+
+template <class Param>
+void makeupAndMixBlock(const float *dry, const float *wet, float *output,
+                       int numSamples, const Param &makeupGain,
+                       const Param &mix) {
+  for (int i = 0; i < numSamples; ++i)
+    output[i] = dry[i] * (1.0f - mix[i]) + wet[i] * makeupGain[i] * mix[i];
+}
+
+// Mix 100%: Dry を読まない（dry * 0 + y と同値。y = -0 のときのみ符号が異なる）
+void makeupFullyWet(const float *wet, float *output, int numSamples,
+                    float makeupGain) {
+  for (int i = 0; i < numSamples; ++i)
+    output[i] = wet[i] * makeupGain;
+}
+
+void makeupAndMixScalar(const float *dry, const float *wet, float *output,
+                        const VT2BControlBlock &control) {
+  if (control.ramping)
+    makeupAndMixBlock(dry, wet, output, control.numSamples,
+                      RampParam{control.makeupGain},
+                      RampParam{control.mixRamp});
+  else if (control.mix == 1.0f)
+    makeupFullyWet(wet, output, control.numSamples, control.drive.makeupGain);
+  else
+    makeupAndMixBlock(dry, wet, output, control.numSamples,
+                      StaticParam{control.drive.makeupGain},
+                      StaticParam{control.mix});
+}
+
+bool isSilentScalar(const float *input, int numSamples, float threshold) {
+  bool silent = true;
+
+  // NaN は比較が偽になるので無音としない（分岐なしで最後まで回す）
+  for (int i = 0; i < numSamples; ++i)
+    silent &= std::abs(input[i]) <= threshold;
+
+  return silent;
+}
+
+bool isFiniteScalar(const float *input, int numSamples) {
+  bool finite = true;
+
+  // 有限なら x - x == 0、NaN / ±Inf なら NaN（分岐なしで最後まで回す）
+  for (int i = 0; i < numSamples; ++i)
+    finite &= input[i] - input[i] == 0.0f;
+
+  return finite;
+}
+
+// スカラー版は長さによらずビット一致する（上限は SIMD 版の最大幅に揃える）
+const VT2BKernelTable scalarReferenceTable = {
+    VT2BSimdLevel::Scalar, VT2BCurvePrecision::Reference, false,
+    VT2BKernels::kMaxLanes, shapeScalar<VT2BCurvePrecision::Reference>,
+    shapeLookupScalar<VT2BCurvePrecision::Reference>, followEnvelopesScalar,
+    followLinkedEnvelopeScalar, transientGainScalar, makeupAndMixScalar,
+    isSilentScalar, isFiniteScalar,
+    VT2BKernelScalar::processShortBlock<VT2BCurvePrecision::Reference>};
+
+const VT2BKernelTable scalarFastTable = {
+    VT2BSimdLevel::Scalar, VT2BCurvePrecision::Fast, true,
+    VT2BKernels::kMaxLanes, shapeScalar<VT2BCurvePrecision::Fast>,
+    shapeLookupScalar<VT2BCurvePrecision::Fast>, followEnvelopesScalar,
+    followLinkedEnvelopeScalar, transientGainScalar, makeupAndMixScalar,
+    isSilentScalar, isFiniteScalar,
+    VT2BKernelScalar::processShortBlock<VT2BCurvePrecision::Fast>};
+} // namespace
+
+const VT2BKernelTable *
+VT2BKernels::getScalarTable(VT2BCurvePrecision precision) {
+  return precision == VT2BCurvePrecision::Reference ? &scalarReferenceTable
+                                                    : &scalarFastTable;
+}
+
+//==============================================================================
+const VT2BKernelTable &VT2BKernels::get(VT2BSimdLevel level,
+                                        VT2BCurvePrecision precision) {
+  const VT2BKernelTable *table = nullptr;
+
+  // std::pow のベクトル版は持たないため、Reference は常にスカラー
+  if (precision == VT2BCurvePrecision::Reference)
+    return *getScalarTable(precision);
+
+  if (VT2BCpuFeatures::isSupported(level)) {
+    switch (level) {
+    case VT2BSimdLevel::AVX512:
+      table = getAVX512Table();
+      break;
+    case VT2BSimdLevel::AVX2:
+      table = getAVX2Table();
+      break;
+    case VT2BSimdLevel::SSE2:
+      table = getSSE2Table();
+      break;
+    case VT2BSimdLevel::NEON:
+      table = getNEONTable();
+      break;
+    case VT2BSimdLevel::Scalar:
+      break;
+    }
+  }
+
+  // 非対応・ビルド対象外の場合は一段ずつ下げる
+  if (table == nullptr) {
+    switch (level) {
+    case VT2BSimdLevel::AVX512:
+      return get(VT2BSimdLevel::AVX2, precision);
+    case VT2BSimdLevel::AVX2:
+      return get(VT2BSimdLevel::SSE2, precision);
+    case VT2BSimdLevel::SSE2:
+    case VT2BSimdLevel::NEON:
+    case VT2BSimdLevel::Scalar:
+      break;
+    }
+
+    return *getScalarTable(precision);
+  }
+
+  return *table;
+}
+
+const VT2BKernelTable &VT2BKernels::getBest() {
+  static const VT2BKernelTable &best =
+      get(VT2BCpuFeatures::getBestSimdLevel());
+  return best;
+}
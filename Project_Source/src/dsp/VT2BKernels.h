@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Vectorized DSP Kernels
+
+    無記憶ステージ（プリゲイン / サチュレーション / 倍音 / ゲイン補償 / Mix）を
+    連続サンプル単位でSIMDレーンに載せて処理する。
+    エンベロープの再帰はサンプル方向に直列なので、チャンネルをレーンに載せる。
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "VT2BCoefficients.h"
+#include "VT2BCpuFeatures.h"
+#include "VT2BSaturationCurve.h"
+#include "VT2BShapeTable.h"
+
+//==============================================================================
+/**
+ * エンベロープ検出のチャンネル間リンク
+ *   Independent  チャンネルごとに独立したエンベロープ（従来の処理）
+ *   Max          全チャンネルの max(|x|) で 1 本のエンベロープを追従する
+ *   Average      全チャンネルの |x| の平均で 1 本のエンベロープを追従する
+ * リンク時は全チャンネルに同じ抑制量がかかるので、定位が動かない。
+ */
+enum class VT2BEnvelopeLink { Independent, Max, Average };
+
+//==============================================================================
+/**
+ * 命令セットごとのカーネル関数テーブル
+ *
+ * 精度（許容誤差）:
+ *   |x|^2.5 の評価は VT2BSaturationCurve を参照。Reference はスカラーのみで、
+ *   従来の処理とビット一致する。SIMD版は常に Fast で、それ以外の演算順序は
+ *   スカラー版と同一。Reference との差は出力の相対誤差で 4 ulp（約 4.8e-7）
+ *   以内とする（コンパイラによるFMA縮約の有無による差もこの範囲に含まれる）。
+ *
+ * 各カーネルは呼び出しごとに係数の状態（静的 / ランプ中、Mix 100%）を判定し、
+ * それぞれ専用にインスタンス化したループを回す（ループ内に分岐はない）。
+ */
+struct VT2BKernelTable {
+  VT2BSimdLevel level;
+  VT2BCurvePrecision precision;
+
+  // shapeLookup が shape より速いか（SIMD版は解析評価でも表引きと同程度）
+  bool prefersShapeLookup;
+
+  // processShortBlock を使うブロック長の上限（未満）。SIMD版はレーン幅
+  int shortBlockLength;
+
+  /**
+   * プリゲイン → サチュレーション → 倍音生成
+   * wet[i] = sat(in[i] * g) + harm(in[i] * g)
+   * 係数は control が静的ならスカラー、ランプ中は係数列から読む。
+   */
+  void (*shape)(const float *input, float *wet,
+                const VT2BControlBlock &control);
+
+  /**
+   * shape の表引き版（静的ブロック専用）
+   * wet[i] = slope[j] * in[i] + intercept[j]、|in[i]| > range のサンプルは
+   * control.drive の係数で解析的に評価する。
+   */
+  void (*shapeLookup)(const float *input, float *wet,
+                      const VT2BShapeLookup &lookup,
+                      const VT2BControlBlock &control);
+
+  /**
+   * エンベロープフォロワー（全チャンネル分）
+   * env = env + (|wet| > env ? attack : release) * (|wet| - env)
+   * チャンネル c の wet / envelope は [c * stride, c * stride + numSamples)、
+   * 状態は state[c]（構造体配列ではなくチャンネル順の float 列）。
+   * 再帰はサンプル方向に直列なので、SIMD版はチャンネルをレーンに載せる。
+   * wet・state はチャンネル数を VT2BKernels::kMaxLanes の倍数に切り上げた分の領域を持つこと
+   * （端数のレーンも計算するが、envelope には書き込まない）。
+   */
+  void (*followEnvelopes)(const float *wet, float *envelope, int stride,
+                          float *state, int numChannels, int numSamples,
+                          float attack, float release);
+
+  /**
+   * チャンネル間でリンクしたエンベロープ（1 本）
+   * 検出値 d[i]（link に応じて全チャンネルの |wet| の max / 平均）を
+   * envelope[0, numSamples) に書き、その場で追従する。状態は state[0]。
+   * 再帰は env = max(env + attack * (d - env), env + release * (d - env))
+   * （attack > release なので followEnvelopes の条件分岐と同じ係数を選ぶ）
+   * を展開した形で評価し、依存の連鎖を短くしている。
+   */
+  void (*followLinkedEnvelope)(const float *wet, float *envelope, int stride,
+                               float *state, int numChannels, int numSamples,
+                               float attack, float release,
+                               VT2BEnvelopeLink link);
+
+  /**
+   * トランジェント整形のゲイン（エンベロープは followEnvelopes で計算済み）
+   * wet[i] *= 1 - min(1, max(0, (env[i] - threshold) / knee)) * amount
+   * NaN のエンベロープは抑制なし（従来の比較と同じ）。
+   */
+  void (*transientGain)(float *wet, const float *envelope,
+                        const VT2BControlBlock &control);
+
+  /**
+   * ゲイン補償 → Dry/Wet ミックス
+   * output[i] = dry[i] * (1 - mix) + wet[i] * makeup * mix
+   * output は dry と同じバッファでもよい。静的ブロックで mix == 1 のときは
+   * dry を読まずに output[i] = wet[i] * makeup とする。
+   */
+  void (*makeupAndMix)(const float *dry, const float *wet, float *output,
+                       const VT2BControlBlock &control);
+
+  /**
+   * 無音判定: 全サンプルで |input[i]| <= threshold か
+   * NaN を含むブロックは無音としない。
+   */
+  bool (*isSilent)(const float *input, int numSamples, float threshold);
+
+  /**
+   * 有限判定: 全サンプルが有限か（NaN / ±Inf を含めば false）
+   * x - x が 0 になるかで判定する（NaN / ±Inf では NaN）。
+   */
+  bool (*isFinite)(const float *input, int numSamples);
+
+  /**
+   * 短いブロックの一括処理（独立エンベロープ、オーバーサンプリング・ADAA なし）
+   * shape（lookup があれば表引き）→ エンベロープ → トランジェント整形 →
+   * ゲイン補償 / Mix を、チャンネルごとにサンプル単位でまとめて回す。
+   * チャンネル c は inputs[c] / outputs[c] の [startSample, +numSamples)、
+   * 状態は state[c]。Wet・エンベロープの作業バッファは使わない。
+   * numSamples < shortBlockLength なら各段を個別に呼んだ場合とビット一致する
+   * （SIMD版はこの長さでは端数ループしか回らないため）。
+   * outputs は inputs と同じバッファでもよい。
+   */
+  void (*processShortBlock)(const float *const *inputs, float *const *outputs,
+                            int numChannels, int startSample, float *state,
+                            const VT2BShapeLookup *lookup,
+                            const VT2BControlBlock &control, float attack,
+                            float release);
+};
+
+namespace VT2BKernels {
+/** 最大の SIMD 幅（AVX-512 の float レーン数） */
+constexpr int kMaxLanes = 16;
+
+/**
+ * 指定レベル・精度のカーネルを返す
+ * 未対応のレベルやビルドに含まれないレベルは実行可能な下位レベルに落とす。
+ * Reference 精度はスカラー版のみ。
+ */
+const VT2BKernelTable &
+get(VT2BSimdLevel level,
+    VT2BCurvePrecision precision = VT2BSaturationCurve::kDefaultPrecision);
+
+/** 実行環境で最速のカーネル（既定の精度） */
+const VT2BKernelTable &getBest();
+
+// 命令セット別テーブル（各翻訳単位で定義。非対応ビルドでは nullptr を返す）
+const VT2BKernelTable *getScalarTable(VT2BCurvePrecision precision);
+const VT2BKernelTable *getSSE2Table();
+const VT2BKernelTable *getAVX2Table();
+const VT2BKernelTable *getAVX512Table();
+const VT2BKernelTable *getNEONTable();
+} // namespace VT2BKernels
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    AVX2 Kernel (8 lanes)
+  ==============================================================================
+*/
+
+#include "VT2BConstants.h"
+#include "VT2BKernelScalar.h"
+#include "VT2BKernels.h"
+
+#include <cmath>
+
+#if VT2B_ARCH_X64
+#include <immintrin.h>
+
+namespace VT2BKernelsAVX2 {
+struct Ops {
+  using Reg = __m256;
+  static constexpr int width = 8;
+
+  VT2B_TARGET_AVX2 static Reg load(const float *p) {
+    return _mm256_loadu_ps(p);
+  }
+  VT2B_TARGET_AVX2 static void store(float *p, Reg v) {
+    _mm256_storeu_ps(p, v);
+  }
+  VT2B_TARGET_AVX2 static Reg set1(float v) { return _mm256_set1_ps(v); }
+  VT2B_TARGET_AVX2 static Reg add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+  VT2B_TARGET_AVX2 static Reg sub(Reg a, Reg b) { return _mm256_sub_ps(a, b); }
+  VT2B_TARGET_AVX2 static Reg mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+  VT2B_TARGET_AVX2 static Reg div(Reg a, Reg b) { return _mm256_div_ps(a, b); }
+  VT2B_TARGET_AVX2 static Reg sqrt(Reg a) { return _mm256_sqrt_ps(a); }
+  VT2B_TARGET_AVX2 static Reg abs(Reg a) {
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a);
+  }
+  VT2B_TARGET_AVX2 static Reg neg(Reg a) {
+    return _mm256_xor_ps(_mm256_set1_ps(-0.0f), a);
+  }
+  VT2B_TARGET_AVX2 static Reg min(Reg a, Reg b) { return _mm256_min_ps(a, b); }
+  VT2B_TARGET_AVX2 static Reg max(Reg a, Reg b) { return _mm256_max_ps(a, b); }
+  VT2B_TARGET_AVX2 static Reg selectNonNegative(Reg x, Reg a, Reg b) {
+    return _mm256_blendv_ps(b, a,
+                            _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GE_OQ));
+  }
+  VT2B_TARGET_AVX2 static bool anyNegative(Reg x) {
+    return _mm256_movemask_ps(
+               _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ)) != 0;
+  }
+
+  using Index = __m256i;
+  VT2B_TARGET_AVX2 static Index truncate(Reg a) {
+    return _mm256_cvttps_epi32(a);
+  }
+  VT2B_TARGET_AVX2 static Reg gather(const float *base, Index index) {
+    return _mm256_i32gather_ps(base, index, 4);
+  }
+};
+
+constexpr VT2BSimdLevel kernelLevel = VT2BSimdLevel::AVX2;
+
+#define VT2B_KERNEL_TARGET VT2B_TARGET_AVX2
+#include "VT2BKernelBody.inl"
+#undef VT2B_KERNEL_TARGET
+} // namespace VT2BKernelsAVX2
+
+const VT2BKernelTable *VT2BKernels::getAVX2Table() {
+  return &VT2BKernelsAVX2::kernelTable;
+}
+#else
+const VT2BKernelTable *VT2BKernels::getAVX2Table() { return nullptr; }
+#endif
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    AVX-512 Kernel (16 lanes)
+  ==============================================================================
+*/
+
+#include "VT2BConstants.h"
+#include "VT2BKernelScalar.h"
+#include "VT2BKernels.h"
+
+#include <cmath>
+
+#if VT2B_ARCH_X64
+#include <immintrin.h>
+
+namespace VT2BKernelsAVX512 {
+struct Ops {
+  using Reg = __m512;
+  static constexpr int width = 16;
+
+  VT2B_TARGET_AVX512 static Reg load(const float *p) {
+    return _mm512_loadu_ps(p);
+  }
+  VT2B_TARGET_AVX512 static void store(float *p, Reg v) {
+    _mm512_storeu_ps(p, v);
+  }
+  VT2B_TARGET_AVX512 static Reg set1(float v) { return _mm512_set1_ps(v); }
+  VT2B_TARGET_AVX512 static Reg add(Reg a, Reg b) {
+    return _mm512_add_ps(a, b);
+  }
+  VT2B_TARGET_AVX512 static Reg sub(Reg a, Reg b) {
+    return _mm512_sub_ps(a, b);
+  }
+  VT2B_TARGET_AVX512 static Reg mul(Reg a, Reg b) {
+    return _mm512_mul_ps(a, b);
+  }
+  VT2B_TARGET_AVX512 static Reg div(Reg a, Reg b) {
+    return _mm512_div_ps(a, b);
+  }
+  // _mm512_sqrt_ps は GCC 12 で未初期化の誤検知警告が出るため maskz 版を使う
+  VT2B_TARGET_AVX512 static Reg sqrt(Reg a) {
+    return _mm512_maskz_sqrt_ps((__mmask16)0xffff, a);
+  }
+  // AVX512F のみで書けるよう、符号ビット操作は整数演算で行う
+  VT2B_TARGET_AVX512 static Reg abs(Reg a) {
+    return _mm512_castsi512_ps(_mm512_and_si512(
+        _mm512_castps_si512(a), _mm512_set1_epi32(0x7fffffff)));
+  }
+  VT2B_TARGET_AVX512 static Reg neg(Reg a) {
+    return _mm512_castsi512_ps(
+        _mm512_xor_si512(_mm512_castps_si512(a),
+                         _mm512_set1_epi32((int)0x80000000u)));
+  }
+  // min/max/cvtt/gather も sqrt と同じ理由でマスク版を使う
+  VT2B_TARGET_AVX512 static Reg min(Reg a, Reg b) {
+    return _mm512_maskz_min_ps((__mmask16)0xffff, a, b);
+  }
+  VT2B_TARGET_AVX512 static Reg max(Reg a, Reg b) {
+    return _mm512_maskz_max_ps((__mmask16)0xffff, a, b);
+  }
+  VT2B_TARGET_AVX512 static Reg selectNonNegative(Reg x, Reg a, Reg b) {
+    __mmask16 mask = _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_GE_OQ);
+    return _mm512_mask_blend_ps(mask, b, a);
+  }
+  VT2B_TARGET_AVX512 static bool anyNegative(Reg x) {
+    return _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_LT_OQ) != 0;
+  }
+
+  using Index = __m512i;
+  VT2B_TARGET_AVX512 static Index truncate(Reg a) {
+    return _mm512_maskz_cvttps_epi32((__mmask16)0xffff, a);
+  }
+  VT2B_TARGET_AVX512 static Reg gather(const float *base, Index index) {
+    return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), (__mmask16)0xffff,
+                                    index, base, 4);
+  }
+};
+
+constexpr VT2BSimdLevel kernelLevel = VT2BSimdLevel::AVX512;
+
+#define VT2B_KERNEL_TARGET VT2B_TARGET_AVX512
+#include "VT2BKernelBody.inl"
+#undef VT2B_KERNEL_TARGET
+} // namespace VT2BKernelsAVX512
+
+const VT2BKernelTable *VT2BKernels::getAVX512Table() {
+  return &VT2BKernelsAVX512::kernelTable;
+}
+#else
+const VT2BKernelTable *VT2BKernels::getAVX512Table() { return nullptr; }
+#endif
@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    NEON Kernel (4 lanes, AArch64)
+  ==============================================================================
+*/
+
+#include "VT2BConstants.h"
+#include "VT2BKernelScalar.h"
+#include "VT2BKernels.h"
+
+#include <cmath>
+
+#if VT2B_ARCH_ARM64
+#include <arm_neon.h>
+
+namespace VT2BKernelsNEON {
+struct Ops {
+  using Reg = float32x4_t;
+  static constexpr int width = 4;
+
+  static Reg load(const float *p) { return vld1q_f32(p); }
+  static void store(float *p, Reg v) { vst1q_f32(p, v); }
+  static Reg set1(float v) { return vdupq_n_f32(v); }
+  static Reg add(Reg a, Reg b) { return vaddq_f32(a, b); }
+  static Reg sub(Reg a, Reg b) { return vsubq_f32(a, b); }
+  static Reg mul(Reg a, Reg b) { return vmulq_f32(a, b); }
+  static Reg div(Reg a, Reg b) { return vdivq_f32(a, b); }
+  static Reg sqrt(Reg a) { return vsqrtq_f32(a); }
+  static Reg abs(Reg a) { return vabsq_f32(a); }
+  static Reg neg(Reg a) { return vnegq_f32(a); }
+  static Reg min(Reg a, Reg b) { return vminq_f32(a, b); }
+  static Reg max(Reg a, Reg b) { return vmaxq_f32(a, b); }
+  static Reg selectNonNegative(Reg x, Reg a, Reg b) {
+    return vbslq_f32(vcgeq_f32(x, vdupq_n_f32(0.0f)), a, b);
+  }
+  static bool anyNegative(Reg x) {
+    return vmaxvq_u32(vcltq_f32(x, vdupq_n_f32(0.0f))) != 0;
+  }
+
+  // NEON にはギャザーがないため、レーンごとに読む
+  // （vcvtq_s32_f32 は NaN を 0 に変換するので範囲外アクセスにならない）
+  using Index = int32x4_t;
+  static Index truncate(Reg a) { return vcvtq_s32_f32(a); }
+  static Reg gather(const float *base, Index index) {
+    Reg result = vdupq_n_f32(base[vgetq_lane_s32(index, 0)]);
+    result = vsetq_lane_f32(base[vgetq_lane_s32(index, 1)], result, 1);
+    result = vsetq_lane_f32(base[vgetq_lane_s32(index, 2)], result, 2);
+    result = vsetq_lane_f32(base[vgetq_lane_s32(index, 3)], result, 3);
+    return result;
+  }
+};
+
+constexpr VT2BSimdLevel kernelLevel = VT2BSimdLevel::NEON;
+
+#define VT2B_KERNEL_TARGET
+#include "VT2BKernelBody.inl"
+#undef VT2B_KERNEL_TARGET
+} // namespace VT2BKernelsNEON
+
+const VT2BKernelTable *VT2BKernels::getNEONTable() {
+  return &VT2BKernelsNEON::kernelTable;
+}
+#else
+const VT2BKernelTable *VT2BKernels::getNEONTable() { return nullptr; }
+#endif
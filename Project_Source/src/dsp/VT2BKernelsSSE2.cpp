@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    SSE2 Kernel (4 lanes)
+  ==============================================================================
+*/
+
+#include "VT2BConstants.h"
+#include "VT2BKernelScalar.h"
+#include "VT2BKernels.h"
+
+#include <cmath>
+
+#if VT2B_ARCH_X64
+#include <emmintrin.h>
+
+namespace VT2BKernelsSSE2 {
+struct Ops {
+  using Reg = __m128;
+  static constexpr int width = 4;
+
+  static Reg load(const float *p) { return _mm_loadu_ps(p); }
+  static void store(float *p, Reg v) { _mm_storeu_ps(p, v); }
+  static Reg set1(float v) { return _mm_set1_ps(v); }
+  static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+  static Reg sub(Reg a, Reg b) { return _mm_sub_ps(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+  static Reg div(Reg a, Reg b) { return _mm_div_ps(a, b); }
+  static Reg sqrt(Reg a) { return _mm_sqrt_ps(a); }
+  static Reg abs(Reg a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+  static Reg neg(Reg a) { return _mm_xor_ps(_mm_set1_ps(-0.0f), a); }
+  static Reg min(Reg a, Reg b) { return _mm_min_ps(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm_max_ps(a, b); }
+  static Reg selectNonNegative(Reg x, Reg a, Reg b) {
+    Reg mask = _mm_cmpge_ps(x, _mm_setzero_ps());
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+  }
+  static bool anyNegative(Reg x) {
+    return _mm_movemask_ps(_mm_cmplt_ps(x, _mm_setzero_ps())) != 0;
+  }
+
+  // SSE2 にはギャザーがないため、インデックスを書き出してスカラーで読む
+  using Index = __m128i;
+  static Index truncate(Reg a) { return _mm_cvttps_epi32(a); }
+  static Reg gather(const float *base, Index index) {
+    alignas(16) int lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i *>(lanes), index);
+    return _mm_setr_ps(base[lanes[0]], base[lanes[1]], base[lanes[2]],
+                       base[lanes[3]]);
+  }
+};
+
+constexpr VT2BSimdLevel kernelLevel = VT2BSimdLevel::SSE2;
+
+#define VT2B_KERNEL_TARGET
+#include "VT2BKernelBody.inl"
+#undef VT2B_KERNEL_TARGET
+} // namespace VT2BKernelsSSE2
+
+const VT2BKernelTable *VT2BKernels::getSSE2Table() {
+  return &VT2BKernelsSSE2::kernelTable;
+}
+#else
+const VT2BKernelTable *VT2BKernels::getSSE2Table() { return nullptr; }
+#endif
@@ -0,0 +1,526 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Polyphase Half-Band Oversampler Implementation
+
+    MinimumPhase: 2系統のオールパス連鎖による半帯域フィルタ
+                  H(z) = 0.5 * (A0(z²) + z⁻¹ A1(z²))
+                  係数は楕円フィルタの設計式（遷移帯域幅と次数から算出）
+    LinearPhase : 奇数タップが中心以外ゼロになる半帯域FIR（Kaiser窓）を
+                  ポリフェーズ分解し、非ゼロタップのみ畳み込む
+  ==============================================================================
+*/
+
+#include "VT2BOversampler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr double pi = 3.14159265358979323846;
+
+//==============================================================================
+// 半帯域オールパス係数の設計（遷移帯域幅 transition は正規化周波数 0 - 0.5）
+double computeAccumulatedNumerator(double q, int order, int c) {
+  double acc = 0.0;
+  double term = 0.0;
+  int sign = 1;
+  int i = 0;
+
+  do {
+    term = std::pow(q, (double)(i * (i + 1))) *
+           std::sin((double)((i * 2 + 1) * c) * pi / (double)order) * sign;
+    acc += term;
+    sign = -sign;
+    ++i;
+  } while (std::abs(term) > 1e-100);
+
+  return acc;
+}
+
+double computeAccumulatedDenominator(double q, int order, int c) {
+  double acc = 0.0;
+  double term = 0.0;
+  int sign = -1;
+  int i = 1;
+
+  do {
+    term = std::pow(q, (double)(i * i)) *
+           std::cos((double)(i * 2 * c) * pi / (double)order) * sign;
+    acc += term;
+    sign = -sign;
+    ++i;
+  } while (std::abs(term) > 1e-100);
+
+  return acc;
+}
+
+std::vector<float> designAllpassCoefficients(int numCoefficients,
+                                             double transition) {
+  double k = std::tan((1.0 - transition * 2.0) * pi / 4.0);
+  k *= k;
+
+  const double kksqrt = std::pow(1.0 - k * k, 0.25);
+  const double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+  const double e4 = e * e * e * e;
+  const double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+  const int order = numCoefficients * 2 + 1;
+  std::vector<float> coefficients((size_t)numCoefficients);
+
+  for (int index = 0; index < numCoefficients; ++index) {
+    const int c = index + 1;
+    const double num =
+        computeAccumulatedNumerator(q, order, c) * std::pow(q, 0.25);
+    const double den = computeAccumulatedDenominator(q, order, c) + 0.5;
+    const double ww = num / den;
+    const double wwsq = ww * ww;
+
+    const double x =
+        std::sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+    coefficients[(size_t)index] = (float)((1.0 - x) / (1.0 + x));
+  }
+
+  return coefficients;
+}
+
+//==============================================================================
+// 0次の第1種変形ベッセル関数（Kaiser窓用）
+double besselI0(double x) {
+  double sum = 1.0;
+  double term = 1.0;
+
+  for (int k = 1; k < 64; ++k) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+
+    if (term < sum * 1e-12)
+      break;
+  }
+
+  return sum;
+}
+
+/**
+ * 半帯域FIRの非ゼロ側タップ（中心から奇数離れたもの）を設計
+ * 全長 4K-1、返すのは h[0], h[2], ..., h[4K-2] の 2K 個。中心タップは 0.5。
+ */
+std::vector<float> designHalfBandTaps(int halfLength,
+                                      double attenuationDb) {
+  const int centre = 2 * halfLength - 1;
+  const double beta = 0.1102 * (attenuationDb - 8.7);
+  const double i0Beta = besselI0(beta);
+
+  std::vector<double> taps((size_t)(2 * halfLength));
+  double sum = 0.0;
+
+  for (int i = 0; i < 2 * halfLength; ++i) {
+    const double offset = (double)(2 * i - centre);
+    const double sinc = std::sin(pi * offset * 0.5) / (pi * offset * 0.5);
+    const double ratio = offset / (double)centre;
+    const double window =
+        besselI0(beta * std::sqrt(std::max(0.0, 1.0 - ratio * ratio))) /
+        i0Beta;
+
+    taps[(size_t)i] = 0.5 * sinc * window;
+    sum += taps[(size_t)i];
+  }
+
+  // 直流ゲインが両位相とも 1 になるよう正規化（非ゼロ側の和 = 0.5）
+  std::vector<float> result(taps.size());
+  for (size_t i = 0; i < taps.size(); ++i)
+    result[i] = (float)(taps[i] * 0.5 / sum);
+
+  return result;
+}
+
+//==============================================================================
+/**
+ * 2倍長の履歴バッファ（同じ値を2箇所に書き、剰余なしで連続読み出しする）
+ * get()[0] が最新、get()[i] が i サンプル前。
+ */
+class HistoryLine {
+public:
+  void prepare(int length) {
+    size = length;
+    data.assign((size_t)(length * 2), 0.0f);
+    position = 0;
+  }
+
+  void clear() {
+    std::fill(data.begin(), data.end(), 0.0f);
+    position = 0;
+  }
+
+  void push(float value) {
+    position = (position == 0 ? size : position) - 1;
+    data[(size_t)position] = value;
+    data[(size_t)(position + size)] = value;
+  }
+
+  const float *get() const { return data.data() + position; }
+
+private:
+  std::vector<float> data;
+  int size = 0;
+  int position = 0;
+};
+
+inline float dot(const float *a, const float *b, int length) {
+  float sum = 0.0f;
+  for (int i = 0; i < length; ++i)
+    sum += a[i] * b[i];
+  return sum;
+}
+} // namespace
+
+//==============================================================================
+struct VT2BOversampler::Stage {
+  virtual ~Stage() = default;
+
+  virtual void prepare(int numChannels) = 0;
+  virtual void reset() = 0;
+  virtual void reset(int channel) = 0;
+
+  /** numSamples → numSamples * 2 */
+  virtual void upsample(int channel, const float *input, float *output,
+                        int numSamples) = 0;
+
+  /** numSamples * 2 → numSamples */
+  virtual void downsample(int channel, const float *input, float *output,
+                          int numSamples) = 0;
+
+  /** アップ＋ダウン往復の遅延（この段の低レート側サンプル） */
+  virtual double getRoundTripDelay() const = 0;
+};
+
+namespace {
+//==============================================================================
+// ポリフェーズ・オールパスIIR（最小位相寄り、低レイテンシ）
+class HalfBandIIR : public VT2BOversampler::Stage {
+public:
+  static constexpr int kMaxCoefficients = 12;
+
+  HalfBandIIR(int numCoefficientsToUse, double transition)
+      : numCoefficients(std::min(numCoefficientsToUse, kMaxCoefficients)) {
+    auto designed = designAllpassCoefficients(numCoefficients, transition);
+    std::copy(designed.begin(), designed.end(), coefficients);
+  }
+
+  void prepare(int numChannels) override {
+    upStates.assign((size_t)numChannels, AllpassState{});
+    downStates.assign((size_t)numChannels, AllpassState{});
+  }
+
+  void reset() override {
+    std::fill(upStates.begin(), upStates.end(), AllpassState{});
+    std::fill(downStates.begin(), downStates.end(), AllpassState{});
+  }
+
+  void reset(int channel) override {
+    upStates[(size_t)channel] = AllpassState{};
+    downStates[(size_t)channel] = AllpassState{};
+  }
+
+  void upsample(int channel, const float *input, float *output,
+                int numSamples) override {
+    auto &state = upStates[(size_t)channel];
+
+    for (int i = 0; i < numSamples; ++i) {
+      float even = input[i];
+      float odd = input[i];
+      processPaths(even, odd, state);
+      output[2 * i] = even;
+      output[2 * i + 1] = odd;
+    }
+  }
+
+  void downsample(int channel, const float *input, float *output,
+                  int numSamples) override {
+    auto &state = downStates[(size_t)channel];
+
+    for (int i = 0; i < numSamples; ++i) {
+      float newer = input[2 * i + 1];
+      float older = input[2 * i];
+      processPaths(newer, older, state);
+      output[i] = 0.5f * (newer + older);
+    }
+  }
+
+  double getRoundTripDelay() const override {
+    // 各オールパス (a + z⁻²)/(1 + a z⁻²) の直流群遅延は 2(1-a)/(1+a)（高レート）
+    double path0 = 0.0;
+    double path1 = 1.0; // z⁻¹
+
+    for (int i = 0; i < numCoefficients; ++i) {
+      const double a = coefficients[i];
+      ((i % 2) == 0 ? path0 : path1) += 2.0 * (1.0 - a) / (1.0 + a);
+    }
+
+    // 1フィルタあたり (path0 + path1) / 2（高レート）、往復で2倍 → 低レート換算。
+    // ダウンサンプラは奇数位相（新しい方）の時刻で出力するため高レート1サンプル分進む
+    return (path0 + path1) * 0.5 - 0.5;
+  }
+
+private:
+  struct AllpassState {
+    float x[kMaxCoefficients] = {};
+    float y[kMaxCoefficients] = {};
+  };
+
+  float coefficients[kMaxCoefficients] = {};
+  int numCoefficients = 0;
+
+  std::vector<AllpassState> upStates;
+  std::vector<AllpassState> downStates;
+
+  // 偶数番目の係数を path0、奇数番目を path1 に交互に割り当てる
+  void processPaths(float &path0, float &path1, AllpassState &state) const {
+    int i = 0;
+
+    for (; i + 1 < numCoefficients; i += 2) {
+      const float out0 =
+          (path0 - state.y[i]) * coefficients[i] + state.x[i];
+      const float out1 =
+          (path1 - state.y[i + 1]) * coefficients[i + 1] + state.x[i + 1];
+
+      state.x[i] = path0;
+      state.x[i + 1] = path1;
+      state.y[i] = out0;
+      state.y[i + 1] = out1;
+
+      path0 = out0;
+      path1 = out1;
+    }
+
+    if (i < numCoefficients) {
+      const float out0 =
+          (path0 - state.y[i]) * coefficients[i] + state.x[i];
+      state.x[i] = path0;
+      state.y[i] = out0;
+      path0 = out0;
+    }
+  }
+};
+
+//==============================================================================
+// ポリフェーズ半帯域FIR（線形位相）
+class HalfBandFIR : public VT2BOversampler::Stage {
+public:
+  HalfBandFIR(int halfLengthToUse, double attenuationDb)
+      : halfLength(halfLengthToUse),
+        taps(designHalfBandTaps(halfLengthToUse, attenuationDb)) {
+    upTaps = taps;
+    for (auto &tap : upTaps)
+      tap *= 2.0f; // ゼロ挿入分のゲイン補償
+  }
+
+  void prepare(int numChannels) override {
+    channels.resize((size_t)numChannels);
+
+    for (auto &c : channels) {
+      c.up.prepare(2 * halfLength);
+      c.downEven.prepare(2 * halfLength);
+      c.downOdd.prepare(halfLength + 1);
+    }
+  }
+
+  void reset() override {
+    for (auto &c : channels) {
+      c.up.clear();
+      c.downEven.clear();
+      c.downOdd.clear();
+    }
+  }
+
+  void reset(int channel) override {
+    auto &c = channels[(size_t)channel];
+    c.up.clear();
+    c.downEven.clear();
+    c.downOdd.clear();
+  }
+
+  void upsample(int channel, const float *input, float *output,
+                int numSamples) override {
+    auto &c = channels[(size_t)channel];
+    const int length = (int)upTaps.size();
+
+    for (int i = 0; i < numSamples; ++i) {
+      c.up.push(input[i]);
+      const float *history = c.up.get();
+
+      // 非ゼロタップ側の位相と、中心タップ（純遅延）側の位相
+      output[2 * i] = dot(upTaps.data(), history, length);
+      output[2 * i + 1] = history[halfLength - 1];
+    }
+  }
+
+  void downsample(int channel, const float *input, float *output,
+                  int numSamples) override {
+    auto &c = channels[(size_t)channel];
+    const int length = (int)taps.size();
+
+    for (int i = 0; i < numSamples; ++i) {
+      c.downEven.push(input[2 * i]);
+      c.downOdd.push(input[2 * i + 1]);
+
+      output[i] = dot(taps.data(), c.downEven.get(), length) +
+                  0.5f * c.downOdd.get()[halfLength];
+    }
+  }
+
+  double getRoundTripDelay() const override {
+    // 1フィルタあたり中心タップ位置 (2K-1) 高レートサンプル、往復で低レート同数
+    return (double)(2 * halfLength - 1);
+  }
+
+private:
+  struct ChannelHistory {
+    HistoryLine up;
+    HistoryLine downEven;
+    HistoryLine downOdd;
+  };
+
+  int halfLength = 0;
+  std::vector<float> taps;
+  std::vector<float> upTaps;
+  std::vector<ChannelHistory> channels;
+};
+} // namespace
+
+//==============================================================================
+VT2BOversampler::VT2BOversampler() = default;
+VT2BOversampler::~VT2BOversampler() = default;
+
+void VT2BOversampler::prepare(int numChannels, int maximumBlockSize,
+                              int factorLog2,
+                              VT2BOversamplingFilter newFilterType) {
+  numStages = std::clamp(factorLog2, 0, kMaxFactorLog2);
+  filterType = newFilterType;
+
+  stages.clear();
+
+  for (int stage = 0; stage < numStages; ++stage) {
+    // 1段目は急峻に、2段目以降はベース帯域への折り返しだけ防げば良いので軽く
+    const bool first = stage == 0;
+
+    if (filterType == VT2BOversamplingFilter::MinimumPhase)
+      stages.push_back(std::make_unique<HalfBandIIR>(first ? 8 : 4,
+                                                     first ? 0.04 : 0.2));
+    else
+      // 半帯域FIRは遷移帯がナイキストをまたぐので、1段目はナイキストのすぐ上
+      // （48 kHz で 26 kHz）から阻止域に入る長さにする（135 タップ）
+      stages.push_back(
+          std::make_unique<HalfBandFIR>(first ? 34 : 6, first ? 90.0 : 80.0));
+
+    stages.back()->prepare(numChannels);
+  }
+
+  const int factor = getFactor();
+  scratchA.allocate(maximumBlockSize * factor);
+  scratchB.allocate(maximumBlockSize * factor);
+
+  // レイテンシ（ベースレート換算）
+  double delayAtMaxRate = 0.0;
+  for (int stage = 0; stage < numStages; ++stage)
+    delayAtMaxRate +=
+        stages[(size_t)stage]->getRoundTripDelay() * (factor >> stage);
+
+  paddingDelay = 0;
+
+  if (filterType == VT2BOversamplingFilter::LinearPhase && numStages > 0) {
+    // FIRの往復遅延は最大レートで整数。ベースレートで整数になるまで補う
+    const int delay = (int)std::lround(delayAtMaxRate);
+    paddingDelay = (factor - delay % factor) % factor;
+    delayAtMaxRate += paddingDelay;
+  }
+
+  latency = delayAtMaxRate / factor;
+
+  paddingLines.assign((size_t)numChannels,
+                      std::vector<float>((size_t)std::max(paddingDelay, 1)));
+  paddingPositions.assign((size_t)numChannels, 0);
+}
+
+void VT2BOversampler::reset() {
+  for (auto &stage : stages)
+    stage->reset();
+
+  for (auto &line : paddingLines)
+    std::fill(line.begin(), line.end(), 0.0f);
+
+  std::fill(paddingPositions.begin(), paddingPositions.end(), 0);
+}
+
+void VT2BOversampler::reset(int channel) {
+  for (auto &stage : stages)
+    stage->reset(channel);
+
+  auto &line = paddingLines[(size_t)channel];
+  std::fill(line.begin(), line.end(), 0.0f);
+  paddingPositions[(size_t)channel] = 0;
+}
+
+//==============================================================================
+void VT2BOversampler::upsample(int channel, const float *input, float *output,
+                               int numSamples) {
+  if (numStages == 0) {
+    std::copy(input, input + numSamples, output);
+    return;
+  }
+
+  // 最終段が output に書き込むよう、段数の偶奇でバッファの順番を決める
+  const float *source = input;
+  int length = numSamples;
+
+  for (int stage = 0; stage < numStages; ++stage) {
+    const bool last = stage == numStages - 1;
+    float *destination =
+        last ? output : ((stage % 2) == 0 ? scratchA.get() : scratchB.get());
+
+    stages[(size_t)stage]->upsample(channel, source, destination, length);
+
+    source = destination;
+    length *= 2;
+  }
+}
+
+void VT2BOversampler::downsample(int channel, float *input, float *output,
+                                 int numSamples) {
+  if (numStages == 0) {
+    std::copy(input, input + numSamples, output);
+    return;
+  }
+
+  int length = numSamples * getFactor();
+
+  if (paddingDelay > 0)
+    applyPadding(channel, input, length);
+
+  const float *source = input;
+
+  for (int stage = numStages - 1; stage >= 0; --stage) {
+    length /= 2;
+    float *destination =
+        stage == 0 ? output : ((stage % 2) == 0 ? scratchA.get() : scratchB.get());
+
+    stages[(size_t)stage]->downsample(channel, source, destination, length);
+    source = destination;
+  }
+}
+
+void VT2BOversampler::applyPadding(int channel, float *data, int numSamples) {
+  auto &line = paddingLines[(size_t)channel];
+  int position = paddingPositions[(size_t)channel];
+
+  for (int i = 0; i < numSamples; ++i) {
+    const float delayed = line[(size_t)position];
+    line[(size_t)position] = data[i];
+    data[i] = delayed;
+
+    if (++position == paddingDelay)
+      position = 0;
+  }
+
+  paddingPositions[(size_t)channel] = position;
+}
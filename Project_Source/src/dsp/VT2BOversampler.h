@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Polyphase Half-Band Oversampler
+
+    非線形ステージ（サチュレーション + 倍音）だけを 2x / 4x / 8x で処理するための
+    多段ハーフバンド・オーバーサンプラー
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "VT2BAlignedBuffer.h"
+
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+ * ハーフバンドフィルタの種類
+ *
+ * MinimumPhase: ポリフェーズ・オールパスIIR。低レイテンシ（2xで約3サンプル）
+ *               だが位相は非線形。
+ * LinearPhase : ポリフェーズFIR（Kaiser窓）。位相は線形だがレイテンシが大きい。
+ */
+enum class VT2BOversamplingFilter { MinimumPhase, LinearPhase };
+
+//==============================================================================
+/**
+ * 多段ハーフバンド・オーバーサンプラー
+ *
+ * 1段目（ベースレート ⇔ 2x）は急峻、2段目以降は遷移帯域を広げて軽くする。
+ * 作業バッファとフィルタ状態は prepare() で確保し、処理中は確保しない。
+ */
+class VT2BOversampler {
+public:
+  static constexpr int kMaxFactorLog2 = 3; // 最大 8x
+
+  VT2BOversampler();
+  ~VT2BOversampler();
+
+  /**
+   * factorLog2: 0 = 1x（バイパス）, 1 = 2x, 2 = 4x, 3 = 8x
+   * オーディオスレッド外で呼ぶこと。
+   */
+  void prepare(int numChannels, int maximumBlockSize, int factorLog2,
+               VT2BOversamplingFilter filterType);
+
+  void reset();
+
+  /** 1 チャンネル分の状態だけ消す（非有限値からの復帰用） */
+  void reset(int channel);
+
+  int getFactor() const { return 1 << numStages; }
+  VT2BOversamplingFilter getFilterType() const { return filterType; }
+
+  /**
+   * ベースレートでのレイテンシ（サンプル）
+   * LinearPhase は整数になるよう内部で遅延を補ってある。
+   * MinimumPhase は低域での群遅延（小数）。
+   */
+  double getLatencyInSamples() const { return latency; }
+
+  /** numSamples（ベースレート）→ numSamples * factor にアップサンプル */
+  void upsample(int channel, const float *input, float *output,
+                int numSamples);
+
+  /**
+   * numSamples * factor → numSamples（ベースレート）にダウンサンプル
+   * input は作業用に書き換えられることがある。
+   */
+  void downsample(int channel, float *input, float *output, int numSamples);
+
+  // 各段の実装（cpp 内で定義）
+  struct Stage;
+
+private:
+  std::vector<std::unique_ptr<Stage>> stages;
+  int numStages = 0;
+  VT2BOversamplingFilter filterType = VT2BOversamplingFilter::MinimumPhase;
+  double latency = 0.0;
+
+  // 段間の作業バッファ（最大レート分）
+  VT2BAlignedBuffer scratchA;
+  VT2BAlignedBuffer scratchB;
+
+  // LinearPhase のレイテンシを整数にするための最大レートでの遅延
+  int paddingDelay = 0;
+  std::vector<std::vector<float>> paddingLines;
+  std::vector<int> paddingPositions;
+
+  void applyPadding(int channel, float *data, int numSamples);
+};
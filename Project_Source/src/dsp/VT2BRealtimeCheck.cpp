@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Realtime Safety Check Implementation
+  ==============================================================================
+*/
+
+#include "VT2BRealtimeCheck.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+// 区間の深さはフック（VT2BRealtimeHooks.cpp の malloc の中）から読むので、
+// 初回アクセスで確保しない TLS モデルにする
+#if defined(__GNUC__)
+#define VT2B_REALTIME_TLS_MODEL __attribute__((tls_model("initial-exec")))
+#else
+#define VT2B_REALTIME_TLS_MODEL
+#endif
+
+namespace {
+thread_local int scopeDepth VT2B_REALTIME_TLS_MODEL = 0;
+thread_local bool reporting VT2B_REALTIME_TLS_MODEL = false;
+
+std::atomic<uint64_t> violationCounts[VT2BRealtimeCheck::kNumViolationTypes];
+std::atomic<int> numRecorded{0};
+std::atomic<const char *> recordedFunctions[VT2BRealtimeCheck::kMaxRecorded];
+std::atomic<int> recordedTypes[VT2BRealtimeCheck::kMaxRecorded];
+
+// -1: 未決定（初回の違反で環境変数 VT2B_REALTIME_TRAP を読む）
+std::atomic<int> trapMode{-1};
+
+bool shouldTrap() {
+  int mode = trapMode.load(std::memory_order_relaxed);
+
+  if (mode < 0) {
+    const char *value = std::getenv("VT2B_REALTIME_TRAP");
+    mode = (value != nullptr && value[0] == '1') ? 1 : 0;
+    trapMode.store(mode, std::memory_order_relaxed);
+  }
+
+  return mode == 1;
+}
+
+[[noreturn]] void trap() {
+#if defined(_MSC_VER)
+  __debugbreak();
+  std::abort();
+#else
+  __builtin_trap();
+#endif
+}
+} // namespace
+
+//==============================================================================
+void VT2BRealtimeCheck::enterScope() noexcept { ++scopeDepth; }
+
+void VT2BRealtimeCheck::exitScope() noexcept { --scopeDepth; }
+
+bool VT2BRealtimeCheck::isInScope() noexcept { return scopeDepth > 0; }
+
+void VT2BRealtimeCheck::report(VT2BRealtimeViolation type,
+                               const char *function) noexcept {
+  // 記録中の出力（write など）が再び違反にならないように
+  if (scopeDepth <= 0 || reporting)
+    return;
+
+  reporting = true;
+
+  violationCounts[(int)type].fetch_add(1, std::memory_order_relaxed);
+  const int index = numRecorded.fetch_add(1, std::memory_order_relaxed);
+
+  // 出力は先頭の kMaxRecorded 件だけ（以降は数えるだけ）
+  if (index < kMaxRecorded) {
+    recordedFunctions[index].store(function, std::memory_order_relaxed);
+    recordedTypes[index].store((int)type, std::memory_order_relaxed);
+
+    char message[192];
+    std::snprintf(message, sizeof(message),
+                  "VT-2B realtime violation: %s (%s) on the audio thread\n",
+                  getName(type), function);
+    std::fputs(message, stderr);
+  }
+
+  if (shouldTrap())
+    trap();
+
+  reporting = false;
+}
+
+uint64_t VT2BRealtimeCheck::getNumViolations() noexcept {
+  uint64_t total = 0;
+
+  for (auto &count : violationCounts)
+    total += count.load(std::memory_order_relaxed);
+
+  return total;
+}
+
+uint64_t VT2BRealtimeCheck::getNumViolations(
+    VT2BRealtimeViolation type) noexcept {
+  return violationCounts[(int)type].load(std::memory_order_relaxed);
+}
+
+void VT2BRealtimeCheck::resetViolations() noexcept {
+  for (auto &count : violationCounts)
+    count.store(0, std::memory_order_relaxed);
+
+  numRecorded.store(0, std::memory_order_relaxed);
+}
+
+int VT2BRealtimeCheck::getRecorded(const char **functions,
+                                   VT2BRealtimeViolation *types,
+                                   int maxEntries) noexcept {
+  int count = numRecorded.load(std::memory_order_relaxed);
+  count = count < kMaxRecorded ? count : kMaxRecorded;
+  count = count < maxEntries ? count : maxEntries;
+
+  for (int i = 0; i < count; ++i) {
+    functions[i] = recordedFunctions[i].load(std::memory_order_relaxed);
+    types[i] =
+        (VT2BRealtimeViolation)recordedTypes[i].load(std::memory_order_relaxed);
+  }
+
+  return count;
+}
+
+void VT2BRealtimeCheck::setTrapOnViolation(bool shouldTrapOnViolation) noexcept {
+  trapMode.store(shouldTrapOnViolation ? 1 : 0, std::memory_order_relaxed);
+}
+
+const char *VT2BRealtimeCheck::getName(VT2BRealtimeViolation type) noexcept {
+  switch (type) {
+  case VT2BRealtimeViolation::Allocation:
+    return "allocation";
+  case VT2BRealtimeViolation::Deallocation:
+    return "deallocation";
+  case VT2BRealtimeViolation::Lock:
+    return "lock";
+  case VT2BRealtimeViolation::BlockingCall:
+    return "blocking call";
+  }
+
+  return "unknown";
+}
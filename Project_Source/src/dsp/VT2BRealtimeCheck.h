@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Realtime Safety Check
+
+    オーディオスレッドの区間（processBlock）を印し、その中で起きたヒープ確保・
+    解放、ロック、ブロックするシステムコールを違反として記録する（デバッグ・
+    テスト用）。まれな条件（パラメータ変更・状態の復元）でだけ確保やロックを
+    するコードを見つけるためのもの。
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstdint>
+
+// 区間の印の有無（-DVT2B_REALTIME_CHECKS=1、CMake では VT2BRealtimeSafetyTest
+// にだけ付く）。違反を拾うフック（operator new / delete の置き換えと glibc の
+// 横取り）は benchmarks/VT2BRealtimeHooks.cpp にあり、テストの実行ファイルに
+// だけ入る。無効時は区間の印も空になる
+#ifndef VT2B_REALTIME_CHECKS
+#define VT2B_REALTIME_CHECKS 0
+#endif
+
+enum class VT2BRealtimeViolation {
+  Allocation,   // operator new / malloc / calloc / realloc / aligned_alloc
+  Deallocation, // operator delete / free
+  Lock,         // pthread_mutex_lock / rwlock / sem_wait
+  BlockingCall  // 条件変数・スリープ・join・ファイル / ソケットの I/O
+};
+
+//==============================================================================
+/**
+ * リアルタイム区間と違反の記録
+ *
+ * 区間はスレッドごと（入れ子可）。違反は区間内の呼び出しだけを数え、関数名を
+ * 標準エラーに書く。setTrapOnViolation(true)（または環境変数
+ * VT2B_REALTIME_TRAP=1）ならその場で止めるので、デバッガで呼び出し元を見られる。
+ * 記録自体は確保・ロックをしない。
+ */
+namespace VT2BRealtimeCheck {
+constexpr int kNumViolationTypes = 4;
+constexpr int kMaxRecorded = 64;
+
+void enterScope() noexcept;
+void exitScope() noexcept;
+bool isInScope() noexcept;
+
+/** 区間内なら違反を記録する（フックから呼ぶ） */
+void report(VT2BRealtimeViolation type, const char *function) noexcept;
+
+uint64_t getNumViolations() noexcept;
+uint64_t getNumViolations(VT2BRealtimeViolation type) noexcept;
+void resetViolations() noexcept;
+
+/** 記録した違反（先頭から最大 kMaxRecorded 件）。戻り値は件数 */
+int getRecorded(const char **functions, VT2BRealtimeViolation *types,
+                int maxEntries) noexcept;
+
+void setTrapOnViolation(bool shouldTrap) noexcept;
+
+const char *getName(VT2BRealtimeViolation type) noexcept;
+} // namespace VT2BRealtimeCheck
+
+/** 区間の印（デストラクタで出る） */
+class VT2BRealtimeScope {
+public:
+  VT2BRealtimeScope() noexcept { VT2BRealtimeCheck::enterScope(); }
+  ~VT2BRealtimeScope() { VT2BRealtimeCheck::exitScope(); }
+
+  VT2BRealtimeScope(const VT2BRealtimeScope &) = delete;
+  VT2BRealtimeScope &operator=(const VT2BRealtimeScope &) = delete;
+};
+
+#if VT2B_REALTIME_CHECKS
+#define VT2B_REALTIME_SCOPE() const VT2BRealtimeScope vt2bRealtimeScope
+#else
+#define VT2B_REALTIME_SCOPE() ((void)0)
+#endif
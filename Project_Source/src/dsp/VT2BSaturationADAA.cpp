@@ -0,0 +1,502 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Antiderivative Anti-Aliasing (ADAA) Implementation
+
+    R(w) = Σ (-w)^n · 4 / (4 + 5n)                   （w < 1 で収束）
+    Q(w) = Σ (-w)^n · 24 / ((4 + 5n)(6 + 5n))
+    どちらも w について解析的で、次の常微分方程式を満たす。
+      R' = 0.8 · (1 / (1 + w) - R) / w
+      Q' = 1.2 · (R - Q) / w
+    w <= 0.5 は級数、そこから上は RK4 で積分して表を作る。
+  ==============================================================================
+*/
+
+#include "VT2BSaturationADAA.h"
+#include "VT2BConstants.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr double pi = 3.14159265358979323846;
+
+// 表の区間。w が大きいほど R, Q は緩やかになるので刻みを粗くする
+// （区間ごとに5次多項式、合計 704 区間）
+struct Tier {
+  double start;
+  double step;
+  int numCells;
+};
+
+constexpr Tier kTiers[] = {{0.0, 1.0 / 32.0, 256},  // [0, 8)
+                           {8.0, 1.0 / 4.0, 224},   // [8, 64)
+                           {64.0, 2.0, 224}};       // [64, 512)
+constexpr int kNumCells = 256 + 224 + 224;
+constexpr double kTableMax = 512.0;
+
+// 漸近級数の項数（w >= 512 で十分すぎるが、Horner なので安価）
+constexpr int kNumAsymptoticTerms = 8;
+
+// 悪条件とみなす差分の大きさ（丸め誤差の増幅が中点近似の誤差を上回る境界）
+constexpr double kFirstOrderTolerance = 1.0e-5;
+constexpr double kSecondOrderTolerance = 1.0e-3;
+
+//==============================================================================
+struct Knot {
+  double value = 0.0;
+  double first = 0.0;
+  double second = 0.0;
+};
+
+// 5次エルミート補間（両端の値・1階・2階微分が一致）の係数
+void makeQuinticCell(const Knot &a, const Knot &b, double h, double *c) {
+  const double f0 = a.value, f1 = b.value;
+  const double d0 = a.first * h, d1 = b.first * h;
+  const double s0 = a.second * h * h, s1 = b.second * h * h;
+  const double df = f1 - f0;
+
+  c[0] = f0;
+  c[1] = d0;
+  c[2] = 0.5 * s0;
+  c[3] = 10.0 * df - 6.0 * d0 - 4.0 * d1 - 1.5 * s0 + 0.5 * s1;
+  c[4] = -15.0 * df + 8.0 * d0 + 7.0 * d1 + 1.5 * s0 - s1;
+  c[5] = 6.0 * df - 3.0 * d0 - 3.0 * d1 - 0.5 * s0 + 0.5 * s1;
+}
+
+//==============================================================================
+struct Tables {
+  double r[kNumCells][6];
+  double q[kNumCells][6];
+
+  // 漸近級数: S1(v) = C - v^-0.5 Σ A_n (-1/w)^n
+  //           S2(v) = D + C·v - v^0.5 Σ B_n (-1/w)^n    （v = w^0.4, k = 1）
+  double asymptoticA[kNumAsymptoticTerms];
+  double asymptoticB[kNumAsymptoticTerms];
+  double constantC = 0.0;
+  double constantD = 0.0;
+
+  Tables() {
+    // w <= 0.5: 級数
+    auto seriesKnots = [](double w, Knot &rKnot, Knot &qKnot) {
+      double power = 1.0; // (-w)^n
+
+      for (int n = 0; n < 64; ++n) {
+        const double cr = 4.0 / (4.0 + 5.0 * n);
+        const double cq = 24.0 / ((4.0 + 5.0 * n) * (6.0 + 5.0 * n));
+
+        rKnot.value += cr * power;
+        qKnot.value += cq * power;
+
+        // d/dw (-w)^n = -n (-w)^(n-1), d²/dw² = n (n-1) (-w)^(n-2)
+        if (n >= 1) {
+          const double p1 = n == 1 ? 1.0 : std::pow(-w, n - 1);
+          rKnot.first -= n * cr * p1;
+          qKnot.first -= n * cq * p1;
+        }
+
+        if (n >= 2) {
+          const double p2 = n == 2 ? 1.0 : std::pow(-w, n - 2);
+          rKnot.second += n * (n - 1) * cr * p2;
+          qKnot.second += n * (n - 1) * cq * p2;
+        }
+
+        power *= -w;
+      }
+    };
+
+    // w > 0.5: 微分方程式から微分を求め、値は RK4 で積分
+    auto derivative = [](double w, double rValue, double qValue,
+                         double &dr, double &dq) {
+      dr = 0.8 * (1.0 / (1.0 + w) - rValue) / w;
+      dq = 1.2 * (rValue - qValue) / w;
+    };
+
+    auto knotsFromValues = [](double w, double rValue, double qValue,
+                              Knot &rk, Knot &qk) {
+      rk.value = rValue;
+      qk.value = qValue;
+      rk.first = 0.8 * (1.0 / (1.0 + w) - rValue) / w;
+      qk.first = 1.2 * (rValue - qValue) / w;
+      rk.second = (-0.8 / ((1.0 + w) * (1.0 + w)) - 1.8 * rk.first) / w;
+      qk.second = (1.2 * rk.first - 2.2 * qk.first) / w;
+    };
+
+    constexpr double kSeriesLimit = 0.5;
+    constexpr int kSubSteps = 128;
+
+    Knot previousR, previousQ;
+    seriesKnots(0.0, previousR, previousQ);
+
+    double w = 0.0;
+    double rValue = previousR.value;
+    double qValue = previousQ.value;
+    int cell = 0;
+
+    for (const auto &tier : kTiers) {
+      for (int i = 0; i < tier.numCells; ++i, ++cell) {
+        const double nextW = tier.start + (i + 1) * tier.step;
+        Knot nextR, nextQ;
+
+        if (nextW <= kSeriesLimit) {
+          seriesKnots(nextW, nextR, nextQ);
+          rValue = nextR.value;
+          qValue = nextQ.value;
+        } else {
+          const double step = tier.step / kSubSteps;
+
+          for (int s = 0; s < kSubSteps; ++s) {
+            double k1r, k1q, k2r, k2q, k3r, k3q, k4r, k4q;
+            derivative(w, rValue, qValue, k1r, k1q);
+            derivative(w + 0.5 * step, rValue + 0.5 * step * k1r,
+                       qValue + 0.5 * step * k1q, k2r, k2q);
+            derivative(w + 0.5 * step, rValue + 0.5 * step * k2r,
+                       qValue + 0.5 * step * k2q, k3r, k3q);
+            derivative(w + step, rValue + step * k3r, qValue + step * k3q,
+                       k4r, k4q);
+
+            rValue += step / 6.0 * (k1r + 2.0 * k2r + 2.0 * k3r + k4r);
+            qValue += step / 6.0 * (k1q + 2.0 * k2q + 2.0 * k3q + k4q);
+            w += step;
+          }
+
+          knotsFromValues(nextW, rValue, qValue, nextR, nextQ);
+        }
+
+        w = nextW; // 刻みの丸め誤差を溜めない
+
+        makeQuinticCell(previousR, nextR, tier.step, this->r[cell]);
+        makeQuinticCell(previousQ, nextQ, tier.step, this->q[cell]);
+        previousR = nextR;
+        previousQ = nextQ;
+      }
+    }
+
+    // 漸近級数の係数。C = ∫0^∞ t / (1 + t^2.5) dt = (π / 2.5) / sin(0.8π)
+    for (int n = 0; n < kNumAsymptoticTerms; ++n) {
+      asymptoticA[n] = 1.0 / (0.5 + 2.5 * n);
+      asymptoticB[n] = 1.0 / ((0.5 + 2.5 * n) * (0.5 - 2.5 * n));
+    }
+
+    constantC = (pi / 2.5) / std::sin(0.8 * pi);
+
+    // D は表の端で Q が連続になるように決める
+    const double p = std::pow(kTableMax, -0.2);
+    const double p4 = p * p * p * p;
+    const double sumB = sumSeries(asymptoticB, kTableMax);
+    constantD =
+        (previousQ.value / 6.0 - constantC * p4 + p4 * p * sumB) / (p4 * p * p);
+  }
+
+  // Σ c_n (-1/w)^n（Horner）
+  static double sumSeries(const double *c, double w) {
+    const double z = -1.0 / w;
+    double sum = c[kNumAsymptoticTerms - 1];
+
+    for (int n = kNumAsymptoticTerms - 2; n >= 0; --n)
+      sum = sum * z + c[n];
+
+    return sum;
+  }
+
+  // w < kTableMax の区間番号と区間内位置 t ∈ [0, 1)
+  static int findCell(double w, double &t) {
+    int first = 0;
+
+    for (const auto &tier : kTiers) {
+      if (w < tier.start + tier.numCells * tier.step) {
+        const double position = (w - tier.start) * (1.0 / tier.step);
+        const int index = std::min((int)position, tier.numCells - 1);
+        t = position - index;
+        return first + index;
+      }
+
+      first += tier.numCells;
+    }
+
+    t = 1.0;
+    return kNumCells - 1;
+  }
+
+  static double evaluateCell(const double *c, double t) {
+    return c[0] + t * (c[1] + t * (c[2] + t * (c[3] + t * (c[4] + t * c[5]))));
+  }
+
+  // R(w) = 2 S1(v) / v²、Q(w) = 6 S2(v) / v³（p = w^-0.2 = v^-0.5）
+  double lookupR(double w) const {
+    if (w < kTableMax) {
+      double t = 0.0;
+      const int cell = findCell(w, t);
+      return evaluateCell(r[cell], t);
+    }
+
+    const double p = std::pow(w, -0.2);
+    const double p4 = p * p * p * p;
+    return 2.0 * p4 * (constantC - p * sumSeries(asymptoticA, w));
+  }
+
+  double lookupQ(double w) const {
+    if (w < kTableMax) {
+      double t = 0.0;
+      const int cell = findCell(w, t);
+      return evaluateCell(q[cell], t);
+    }
+
+    const double p = std::pow(w, -0.2);
+    const double p4 = p * p * p * p;
+    return 6.0 * p4 *
+           (constantD * p * p + constantC - p * sumSeries(asymptoticB, w));
+  }
+};
+
+// 初回呼び出しで構築（prepare() から呼んでオーディオスレッドでの構築を避ける）
+const Tables &getTables() {
+  static const Tables tables;
+  return tables;
+}
+
+inline double saturationVariable(double absX, double k) {
+  return k * absX * absX * std::sqrt(absX);
+}
+} // namespace
+
+//==============================================================================
+namespace VT2BAntiderivative {
+Shape Shape::fromCoefficients(float normalizedDrive, float saturationK) {
+  Shape shape;
+  shape.k = saturationK;
+  shape.harmonic2 = (double)VT2BConstants::kHarmonic2ndAmount * normalizedDrive;
+  shape.harmonic3 = (double)VT2BConstants::kHarmonic3rdAmount * normalizedDrive;
+  return shape;
+}
+
+double evaluate(double x, const Shape &shape) {
+  const double u = std::abs(x);
+  return x / (1.0 + saturationVariable(u, shape.k)) +
+         shape.harmonic2 * x * u + shape.harmonic3 * x * x * x;
+}
+
+double first(double x, const Shape &shape) {
+  const double u = std::abs(x);
+  const double u2 = u * u;
+  const double r = getTables().lookupR(saturationVariable(u, shape.k));
+
+  return 0.5 * u2 * r + shape.harmonic2 * u2 * u * (1.0 / 3.0) +
+         shape.harmonic3 * u2 * u2 * 0.25;
+}
+
+double second(double x, const Shape &shape) {
+  const double u = std::abs(x);
+  const double u2 = u * u;
+  const double q = getTables().lookupQ(saturationVariable(u, shape.k));
+
+  return x * u2 * (1.0 / 6.0) * q + shape.harmonic2 * x * u2 * u * (1.0 / 12.0) +
+         shape.harmonic3 * x * u2 * u2 * 0.05;
+}
+} // namespace VT2BAntiderivative
+
+//==============================================================================
+namespace {
+using VT2BAntiderivative::Shape;
+
+inline bool operator!=(const Shape &a, const Shape &b) {
+  return a.k != b.k || a.harmonic2 != b.harmonic2 ||
+         a.harmonic3 != b.harmonic3;
+}
+
+// 1次: (G1(x0) - G1(x1)) / (x0 - x1)、悪条件なら中点の g
+inline double firstOrderOutput(double x0, double x1, double g0, double g1,
+                               const Shape &shape) {
+  const double difference = x0 - x1;
+
+  if (std::abs(difference) < kFirstOrderTolerance)
+    return VT2BAntiderivative::evaluate(0.5 * (x0 + x1), shape);
+
+  return (g0 - g1) / difference;
+}
+
+// 2次で使う G2 の差分商、悪条件なら中点の G1
+inline double secondOrderSlope(double x0, double x1, double g0, double g1,
+                               const Shape &shape) {
+  const double difference = x0 - x1;
+
+  if (std::abs(difference) < kSecondOrderTolerance)
+    return VT2BAntiderivative::first(0.5 * (x0 + x1), shape);
+
+  return (g0 - g1) / difference;
+}
+
+// 2次: 2 / (x0 - x2) · (slope01 - slope12)
+// x0 ≈ x2 のときは x̄ = (x0 + x2) / 2 で展開した式に切り替える
+inline double secondOrderOutput(double x0, double x1, double x2,
+                                double slope01, double slope12,
+                                const Shape &shape) {
+  const double difference = x0 - x2;
+
+  if (std::abs(difference) >= kSecondOrderTolerance)
+    return 2.0 * (slope01 - slope12) / difference;
+
+  const double mean = 0.5 * (x0 + x2);
+  const double delta = mean - x1;
+
+  if (std::abs(delta) < kSecondOrderTolerance)
+    return VT2BAntiderivative::evaluate(0.5 * (mean + x1), shape);
+
+  return 2.0 / delta *
+         (VT2BAntiderivative::first(mean, shape) +
+          (VT2BAntiderivative::second(x1, shape) -
+           VT2BAntiderivative::second(mean, shape)) /
+              delta);
+}
+} // namespace
+
+//==============================================================================
+void VT2BSaturationADAA::prepare(int numChannels) {
+  getTables();
+  channelStates.assign((size_t)std::max(numChannels, 0), ChannelState{});
+}
+
+void VT2BSaturationADAA::reset() {
+  for (auto &state : channelStates)
+    state = ChannelState{};
+}
+
+void VT2BSaturationADAA::reset(int channel) {
+  channelStates[(size_t)channel] = ChannelState{};
+}
+
+double VT2BSaturationADAA::getDelayInSamples() const {
+  switch (mode) {
+  case VT2BAntialiasing::ADAA1:
+    return 0.5;
+  case VT2BAntialiasing::ADAA2:
+    return 1.0;
+  case VT2BAntialiasing::Off:
+    break;
+  }
+
+  return 0.0;
+}
+
+void VT2BSaturationADAA::process(int channel, const float *input, float *wet,
+                                 const VT2BControlBlock &control) {
+  auto &state = channelStates[(size_t)channel];
+
+  if (mode == VT2BAntialiasing::ADAA2)
+    processSecondOrder(state, input, wet, control);
+  else
+    processFirstOrder(state, input, wet, control);
+}
+
+void VT2BSaturationADAA::processFirstOrder(ChannelState &state,
+                                           const float *input, float *wet,
+                                           const VT2BControlBlock &control) {
+  const int numSamples = control.numSamples;
+  double x1 = state.x1;
+
+  if (control.ramping) {
+    // 係数が毎サンプル変わるので、直前の入力も現在の係数で評価し直す
+    for (int i = 0; i < numSamples; ++i) {
+      const Shape shape = Shape::fromCoefficients(control.normalizedDrive[i],
+                                                  control.saturationK[i]);
+      const double x0 = (double)input[i] * control.preDriveGain[i];
+
+      wet[i] = (float)firstOrderOutput(
+          x0, x1, VT2BAntiderivative::first(x0, shape),
+          VT2BAntiderivative::first(x1, shape), shape);
+      x1 = x0;
+    }
+
+    state.x1 = x1;
+    state.cacheValid = false; // 次の静的ブロックで評価し直させる
+    return;
+  }
+
+  const Shape shape = Shape::fromCoefficients(control.drive.normalizedDrive,
+                                              control.drive.saturationK);
+  const double gain = control.drive.preDriveGain;
+  double g1 = state.g1;
+
+  if (!state.cacheValid || state.cachedShape != shape)
+    g1 = VT2BAntiderivative::first(x1, shape);
+
+  for (int i = 0; i < numSamples; ++i) {
+    const double x0 = (double)input[i] * gain;
+    const double g0 = VT2BAntiderivative::first(x0, shape);
+
+    wet[i] = (float)firstOrderOutput(x0, x1, g0, g1, shape);
+    x1 = x0;
+    g1 = g0;
+  }
+
+  state.x1 = x1;
+  state.g1 = g1;
+  state.cachedShape = shape;
+  state.cacheValid = true;
+}
+
+void VT2BSaturationADAA::processSecondOrder(ChannelState &state,
+                                            const float *input, float *wet,
+                                            const VT2BControlBlock &control) {
+  const int numSamples = control.numSamples;
+  double x1 = state.x1;
+  double x2 = state.x2;
+
+  if (control.ramping) {
+    for (int i = 0; i < numSamples; ++i) {
+      const Shape shape = Shape::fromCoefficients(control.normalizedDrive[i],
+                                                  control.saturationK[i]);
+      const double x0 = (double)input[i] * control.preDriveGain[i];
+
+      const double g0 = VT2BAntiderivative::second(x0, shape);
+      const double g1 = VT2BAntiderivative::second(x1, shape);
+      const double g2 = VT2BAntiderivative::second(x2, shape);
+
+      const double slope01 = secondOrderSlope(x0, x1, g0, g1, shape);
+      const double slope12 = secondOrderSlope(x1, x2, g1, g2, shape);
+
+      wet[i] = (float)secondOrderOutput(x0, x1, x2, slope01, slope12, shape);
+      x2 = x1;
+      x1 = x0;
+    }
+
+    state.x1 = x1;
+    state.x2 = x2;
+    state.cacheValid = false;
+    return;
+  }
+
+  const Shape shape = Shape::fromCoefficients(control.drive.normalizedDrive,
+                                              control.drive.saturationK);
+  const double gain = control.drive.preDriveGain;
+  double g1 = state.g1;
+  double g2 = state.g2;
+
+  if (!state.cacheValid || state.cachedShape != shape) {
+    g1 = VT2BAntiderivative::second(x1, shape);
+    g2 = VT2BAntiderivative::second(x2, shape);
+  }
+
+  double slope12 = secondOrderSlope(x1, x2, g1, g2, shape);
+
+  for (int i = 0; i < numSamples; ++i) {
+    const double x0 = (double)input[i] * gain;
+    const double g0 = VT2BAntiderivative::second(x0, shape);
+    const double slope01 = secondOrderSlope(x0, x1, g0, g1, shape);
+
+    wet[i] = (float)secondOrderOutput(x0, x1, x2, slope01, slope12, shape);
+
+    x2 = x1;
+    x1 = x0;
+    g2 = g1;
+    g1 = g0;
+    slope12 = slope01;
+  }
+
+  state.x1 = x1;
+  state.x2 = x2;
+  state.g1 = g1;
+  state.g2 = g2;
+  state.cachedShape = shape;
+  state.cacheValid = true;
+}
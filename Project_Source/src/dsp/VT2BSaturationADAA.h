@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Antiderivative Anti-Aliasing (ADAA)
+
+    無記憶ステージ g(x) = x / (1 + k|x|^2.5) + a2·x|x| + a3·x³ を
+    原始関数の差分商で評価し、オーバーサンプリングなしで折り返しを抑える。
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "VT2BCoefficients.h"
+
+#include <vector>
+
+//==============================================================================
+/**
+ * サチュレーション段の折り返し対策
+ *
+ * Off  : そのまま評価（SIMDカーネル）
+ * ADAA1: 1次 ADAA。遅延 0.5 サンプル、高域が緩やかに減衰
+ * ADAA2: 2次 ADAA。遅延 1 サンプル、折り返しの抑制量が大きい
+ */
+enum class VT2BAntialiasing { Off, ADAA1, ADAA2 };
+
+//==============================================================================
+/**
+ * g(x) の原始関数（入力 x はプリゲイン適用後）
+ *
+ * サチュレーション項の原始関数は初等関数で書けないため、w = k|x|^2.5 を
+ * 変数にとった無次元関数 R(w), Q(w) を使う。
+ *
+ *   G1(x) = x²/2 · R(w) + a2·|x|³/3 + a3·x⁴/4        （G1' = g）
+ *   G2(x) = x³/6 · Q(w) + a2·x|x|³/12 + a3·x⁵/20     （G2' = G1）
+ *
+ * R, Q は k に依存しないので、Drive のスムージング中も同じ表を使える。
+ * w <= 8 は5次エルミート補間の表、それより上は漸近級数で評価する。
+ */
+namespace VT2BAntiderivative {
+struct Shape {
+  double k = 0.0;
+  double harmonic2 = 0.0; // a2 = kHarmonic2ndAmount * normalizedDrive
+  double harmonic3 = 0.0; // a3 = kHarmonic3rdAmount * normalizedDrive
+
+  static Shape fromCoefficients(float normalizedDrive, float saturationK);
+};
+
+double evaluate(double x, const Shape &shape); // g(x)
+double first(double x, const Shape &shape);    // G1(x)
+double second(double x, const Shape &shape);   // G2(x)
+} // namespace VT2BAntiderivative
+
+//==============================================================================
+/**
+ * ADAA によるサチュレーション + 倍音生成
+ *
+ * VT2BKernelTable::shape の代わりに呼ぶ。出力の各サンプルは g を入力の線分
+ * （2次では三角窓）上で平均したものなので、同じ出力サンプルの計算には
+ * 同じ係数を使う。これにより k がサンプルごとに動いても出力は g の値域に
+ * 収まり、発散しない。
+ *
+ * 差分が小さい（悪条件の）ときは中点での g / G1 に切り替える。
+ * 演算は double。
+ */
+class VT2BSaturationADAA {
+public:
+  /** 状態確保（オーディオスレッド外） */
+  void prepare(int numChannels);
+  void reset();
+  void reset(int channel);
+
+  void setMode(VT2BAntialiasing newMode) { mode = newMode; }
+  VT2BAntialiasing getMode() const { return mode; }
+
+  /** 処理レートでの群遅延（ADAA1: 0.5, ADAA2: 1.0 サンプル） */
+  double getDelayInSamples() const;
+
+  /** wet[i] = g(input[i] * preDriveGain)（ADAA） */
+  void process(int channel, const float *input, float *wet,
+               const VT2BControlBlock &control);
+
+private:
+  struct ChannelState {
+    // 直前の入力（プリゲイン適用後）
+    double x1 = 0.0;
+    double x2 = 0.0;
+
+    // 静的ブロック用: 直前の入力に対する原始関数値（cachedShape で評価済み）
+    double g1 = 0.0;
+    double g2 = 0.0;
+    VT2BAntiderivative::Shape cachedShape;
+    bool cacheValid = false;
+  };
+
+  VT2BAntialiasing mode = VT2BAntialiasing::Off;
+  std::vector<ChannelState> channelStates;
+
+  void processFirstOrder(ChannelState &state, const float *input, float *wet,
+                         const VT2BControlBlock &control);
+  void processSecondOrder(ChannelState &state, const float *input, float *wet,
+                          const VT2BControlBlock &control);
+};
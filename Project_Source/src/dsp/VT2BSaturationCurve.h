@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Saturation Curve Evaluator
+
+    サチュレーション f(x) = x / (1 + k * |x|^n) の |x|^n 部分（n = 2.5 固定）
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "VT2BConstants.h"
+
+#include <cmath>
+
+//==============================================================================
+/**
+ * |x|^2.5 の評価精度
+ *
+ * Reference: std::pow。従来処理とビット一致（スカラーのみ）
+ * Fast     : x² · √x。sqrt は IEEE で正しく丸められるため、
+ *            [2^-48, 16] の全 float について std::pow(double) に対する
+ *            相対誤差は最大 1.72e-7（約 1.44 ulp、-135 dB）。
+ *            SIMD カーネルはこちらを使う。
+ */
+enum class VT2BCurvePrecision { Reference, Fast };
+
+// コンパイル時の既定値（-DVT2B_SATURATION_CURVE_REFERENCE=1 で Reference）
+#ifndef VT2B_SATURATION_CURVE_REFERENCE
+#define VT2B_SATURATION_CURVE_REFERENCE 0
+#endif
+
+namespace VT2BSaturationCurve {
+constexpr VT2BCurvePrecision kDefaultPrecision =
+    VT2B_SATURATION_CURVE_REFERENCE ? VT2BCurvePrecision::Reference
+                                    : VT2BCurvePrecision::Fast;
+
+/** Fast モードの最大相対誤差（上記の全数検査による実測値） */
+constexpr float kFastMaxRelativeError = 1.72e-7f;
+
+// 指数 2.5 = 2 + 0.5 を前提にした特殊化
+static_assert(VT2BConstants::kSaturationCurve == 2.5f,
+              "Fast evaluator assumes |x|^2.5");
+
+inline float evaluateReference(float absInput) {
+  return std::pow(absInput, VT2BConstants::kSaturationCurve);
+}
+
+inline float evaluateFast(float absInput) {
+  return absInput * absInput * std::sqrt(absInput);
+}
+
+template <VT2BCurvePrecision precision> inline float evaluate(float absInput) {
+  if constexpr (precision == VT2BCurvePrecision::Reference)
+    return evaluateReference(absInput);
+  else
+    return evaluateFast(absInput);
+}
+} // namespace VT2BSaturationCurve
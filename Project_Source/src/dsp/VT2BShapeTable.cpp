@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Per-Drive Transfer Function Table Implementation
+
+    f(in) = φ(g · in)
+    φ(x)  = x / (1 + k|x|^2.5) + a2·x|x| + a3·x³
+    φ''(x) = sgn(x)·k|x|^1.5·(-3.75·D - 5·N) / D³ + 2·a2·sgn(x) + 6·a3·x
+             （D = 1 + k|x|^2.5, N = 1 - 1.5·k|x|^2.5）
+  ==============================================================================
+*/
+
+#include "VT2BShapeTable.h"
+#include "VT2BConstants.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace {
+constexpr double kCellWidth =
+    2.0 * VT2BShapeTable::kInputRange / VT2BShapeTable::kNumCells;
+
+// 区間内で f'' を調べる点の数（両端を含む）
+constexpr int kCurvatureProbes = 9;
+
+struct Curve {
+  double gain = 1.0;
+  double k = 0.0;
+  double harmonic2 = 0.0;
+  double harmonic3 = 0.0;
+
+  explicit Curve(const VT2BDriveCoefficients &drive)
+      : gain(drive.preDriveGain), k(drive.saturationK),
+        harmonic2((double)VT2BConstants::kHarmonic2ndAmount *
+                  drive.normalizedDrive),
+        harmonic3((double)VT2BConstants::kHarmonic3rdAmount *
+                  drive.normalizedDrive) {}
+
+  double value(double input) const {
+    const double x = input * gain;
+    const double u = std::abs(x);
+    return x / (1.0 + k * u * u * std::sqrt(u)) + harmonic2 * x * u +
+           harmonic3 * x * x * x;
+  }
+
+  double secondDerivative(double input) const {
+    const double x = input * gain;
+    const double u = std::abs(x);
+    const double sign = x < 0.0 ? -1.0 : 1.0;
+    const double u15 = u * std::sqrt(u);
+    const double w = k * u * u15;
+    const double d = 1.0 + w;
+    const double n = 1.0 - 1.5 * w;
+
+    const double saturation = sign * k * u15 * (-3.75 * d - 5.0 * n) / (d * d * d);
+    return gain * gain *
+           (saturation + 2.0 * harmonic2 * sign + 6.0 * harmonic3 * x);
+  }
+};
+
+double knotPosition(int index) {
+  return -(double)VT2BShapeTable::kInputRange + index * kCellWidth;
+}
+} // namespace
+
+//==============================================================================
+void VT2BShapeTable::prepare() {
+  for (auto &table : tables) {
+    table.slope.allocate(kNumCells);
+    table.intercept.allocate(kNumCells);
+
+    table.lookup.slope = table.slope.get();
+    table.lookup.intercept = table.intercept.get();
+    table.lookup.scale = (float)(1.0 / kCellWidth);
+    table.lookup.offset = (float)(kInputRange / kCellWidth);
+    table.lookup.lastCell = (float)(kNumCells - 1);
+    table.lookup.range = kInputRange;
+  }
+
+  reset();
+}
+
+void VT2BShapeTable::reset() {
+  for (auto &table : tables)
+    table.valid = false;
+
+  building = false;
+  builtCells = 0;
+}
+
+const VT2BShapeLookup *
+VT2BShapeTable::update(const VT2BDriveCoefficients &drive, int cellBudget) {
+  auto &current = tables[active];
+
+  if (current.valid && current.drive.drive == drive.drive)
+    return &current.lookup;
+
+  auto &pending = tables[1 - active];
+
+  // 目標が変わったら最初から作り直す
+  if (!building || pending.drive.drive != drive.drive) {
+    pending.valid = false;
+    pending.drive = drive;
+    building = true;
+    builtCells = 0;
+    buildErrorBound = 0.0;
+    previousKnot = Curve(drive).value(knotPosition(0));
+  }
+
+  buildCells(pending, std::max(cellBudget, 1));
+
+  if (builtCells < kNumCells)
+    return nullptr;
+
+  // 完成: 差し替え
+  pending.errorBound = (float)buildErrorBound;
+  pending.valid = true;
+  building = false;
+  active = 1 - active;
+  return &pending.lookup;
+}
+
+void VT2BShapeTable::buildCells(Table &table, int numCells) {
+  const Curve curve(table.drive);
+  const int end = std::min(builtCells + numCells, kNumCells);
+  float *slope = table.slope.get();
+  float *intercept = table.intercept.get();
+
+  for (int cell = builtCells; cell < end; ++cell) {
+    const double left = knotPosition(cell);
+    const double right = knotPosition(cell + 1);
+    const double nextKnot = curve.value(right);
+
+    const double cellSlope = (nextKnot - previousKnot) / kCellWidth;
+    const double cellIntercept = previousKnot - cellSlope * left;
+
+    slope[cell] = (float)cellSlope;
+    intercept[cell] = (float)cellIntercept;
+
+    // 補間誤差 h²/8 · max|f''| と、float での係数保持・積和の丸め
+    double curvature = 0.0;
+
+    for (int probe = 0; probe < kCurvatureProbes; ++probe)
+      curvature = std::max(
+          curvature,
+          std::abs(curve.secondDerivative(
+              left + kCellWidth * probe / (kCurvatureProbes - 1))));
+
+    const double magnitude =
+        std::abs(cellSlope) * std::max(std::abs(left), std::abs(right)) +
+        std::abs(cellIntercept);
+
+    buildErrorBound =
+        std::max(buildErrorBound, kCellWidth * kCellWidth / 8.0 * curvature +
+                                      2.0 * FLT_EPSILON * magnitude);
+
+    previousKnot = nextKnot;
+  }
+
+  builtCells = end;
+}
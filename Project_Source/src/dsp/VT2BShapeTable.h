@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Per-Drive Transfer Function Table
+
+    Drive 固定時、プリゲイン → サチュレーション → 倍音 は入力サンプルだけの関数。
+    これを区分線形の表にして、1サンプルあたり「表引き + 積和」で評価する。
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "VT2BAlignedBuffer.h"
+#include "VT2BCoefficients.h"
+
+//==============================================================================
+/**
+ * カーネルに渡す表の参照
+ *
+ * 区間 j では wet = slope[j] * input + intercept[j]。
+ * |input| > range のサンプルは呼び出し側（カーネル）で解析的に評価する。
+ */
+struct VT2BShapeLookup {
+  const float *slope = nullptr;
+  const float *intercept = nullptr;
+  float scale = 0.0f;    // 1 / 区間幅
+  float offset = 0.0f;   // range / 区間幅
+  float lastCell = 0.0f; // 区間数 - 1
+  float range = 0.0f;
+
+  /** 表の範囲内の入力を評価（NaN は区間 0 に落ちて NaN を返す） */
+  float evaluate(float input) const {
+    float position = input * scale + offset;
+    position = position > 0.0f ? position : 0.0f;
+    position = position < lastCell ? position : lastCell;
+
+    const int index = (int)position;
+    return slope[index] * input + intercept[index];
+  }
+};
+
+//==============================================================================
+/**
+ * Drive ごとの伝達関数表
+ *
+ * Drive の目標値が変わると、ブロックごとに一定数の区間ずつ裏側の表を作り直し、
+ * 完成したら表を差し替える（オーディオスレッド上で償却、確保・ロックなし）。
+ * 作り直しの間とランプ中は nullptr を返し、呼び出し側は解析評価を使う。
+ *
+ * 誤差: 区間ごとに h²/8 · max|f''|（f'' は区間内の9点で解析的に評価）と
+ *       float の丸めを合算した上限を getErrorBound() で返す。
+ */
+class VT2BShapeTable {
+public:
+  static constexpr int kNumCells = 2048;
+  static constexpr float kInputRange = 2.0f; // +6 dBFS まで
+
+  /** バッファ確保（オーディオスレッド外） */
+  void prepare();
+
+  /** 表を破棄（次の update() から作り直し） */
+  void reset();
+
+  /**
+   * 静的ブロックごとに呼ぶ
+   * drive 用の表が完成していればそれを返す。未完成なら最大 cellBudget 区間だけ
+   * 構築を進めて nullptr を返す。
+   */
+  const VT2BShapeLookup *update(const VT2BDriveCoefficients &drive,
+                                int cellBudget);
+
+  /** 現在有効な表の誤差上限（絶対値） */
+  float getErrorBound() const { return tables[active].errorBound; }
+
+private:
+  struct Table {
+    VT2BAlignedBuffer slope;
+    VT2BAlignedBuffer intercept;
+    VT2BShapeLookup lookup;
+    VT2BDriveCoefficients drive;
+    float errorBound = 0.0f;
+    bool valid = false;
+  };
+
+  Table tables[2];
+  int active = 0;
+
+  // 裏側の表の構築状況
+  bool building = false;
+  int builtCells = 0;
+  double previousKnot = 0.0;
+  double buildErrorBound = 0.0;
+
+  void buildCells(Table &table, int numCells);
+};
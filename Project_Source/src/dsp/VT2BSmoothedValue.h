@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Linear Smoothed Value
+
+    juce::SmoothedValue<float>（Linear）と同じステップ列を返す軽量版。
+    DSPエンジンをJUCE非依存に保つために使用する。
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cmath>
+
+//==============================================================================
+/**
+ * 線形スムーザー
+ *
+ * reset / setTargetValue / getNextValue の挙動は juce::SmoothedValue と同一。
+ * プラグイン版と同じ出力になるよう、丸め方も含めて合わせてある。
+ */
+class VT2BSmoothedValue {
+public:
+  VT2BSmoothedValue() = default;
+
+  /** ランプ長を設定し、現在値を目標値にスナップする */
+  void reset(double sampleRate, double rampLengthInSeconds) {
+    stepsToTarget = (int)std::floor(rampLengthInSeconds * sampleRate);
+    setCurrentAndTargetValue(target);
+  }
+
+  void setCurrentAndTargetValue(float newValue) {
+    target = currentValue = newValue;
+    countdown = 0;
+  }
+
+  void setTargetValue(float newValue) {
+    if (newValue == target)
+      return;
+
+    if (stepsToTarget <= 0) {
+      setCurrentAndTargetValue(newValue);
+      return;
+    }
+
+    target = newValue;
+    countdown = stepsToTarget;
+    step = (target - currentValue) / (float)countdown;
+  }
+
+  float getNextValue() {
+    if (!isSmoothing())
+      return target;
+
+    --countdown;
+
+    if (isSmoothing())
+      currentValue += step;
+    else
+      currentValue = target;
+
+    return currentValue;
+  }
+
+  bool isSmoothing() const { return countdown > 0; }
+  float getCurrentValue() const { return currentValue; }
+  float getTargetValue() const { return target; }
+
+private:
+  float currentValue = 0.0f;
+  float target = 0.0f;
+  float step = 0.0f;
+  int countdown = 0;
+  int stepsToTarget = 0;
+};
@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Meter Telemetry
+
+    オーディオスレッドからエディターへメーター値（入出力のピーク・RMS と
+    トランジェント整形のゲインリダクション）を渡す。単一プロデューサー /
+    単一コンシューマーの待ちなしキューで、ロック・確保・RMW 命令を使わない。
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+
+//==============================================================================
+/**
+ * 単一プロデューサー / 単一コンシューマーの待ちなしキュー
+ *
+ * push() はプロデューサーのスレッドだけ、pop() はコンシューマーのスレッドだけが
+ * 呼ぶ。満杯なら push() は何もせず false を返す（メーターは読まれなかった分を
+ * 捨ててよい）。読み位置と書き位置は別のキャッシュラインに置き、相手の位置は
+ * 手元に写しておいて、満杯 / 空に見えたときだけ読み直す。
+ */
+template <typename T, size_t Capacity> class VT2BSpscQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+
+public:
+  bool push(const T &item) {
+    const size_t write = writeIndex.load(std::memory_order_relaxed);
+
+    if (write - cachedReadIndex == Capacity) {
+      cachedReadIndex = readIndex.load(std::memory_order_acquire);
+
+      if (write - cachedReadIndex == Capacity)
+        return false;
+    }
+
+    items[write & (Capacity - 1)] = item;
+    writeIndex.store(write + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T &item) {
+    const size_t read = readIndex.load(std::memory_order_relaxed);
+
+    if (read == cachedWriteIndex) {
+      cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+
+      if (read == cachedWriteIndex)
+        return false;
+    }
+
+    item = items[read & (Capacity - 1)];
+    readIndex.store(read + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  static constexpr size_t kCacheLine = 64;
+
+  // プロデューサー側
+  alignas(kCacheLine) std::atomic<size_t> writeIndex{0};
+  size_t cachedReadIndex = 0;
+
+  // コンシューマー側
+  alignas(kCacheLine) std::atomic<size_t> readIndex{0};
+  size_t cachedWriteIndex = 0;
+
+  alignas(kCacheLine) std::array<T, Capacity> items{};
+};
+
+//==============================================================================
+/** 1 フレーム分のメーター値（全チャンネルの最大、リニア） */
+struct VT2BMeterFrame {
+  float inputPeak = 0.0f;
+  float inputRms = 0.0f;
+  float outputPeak = 0.0f;
+  float outputRms = 0.0f;
+  float gainReduction = 1.0f; // トランジェント整形のゲイン（1 = 抑制なし）
+};
+
+//==============================================================================
+/**
+ * メーター値の集計と受け渡し
+ *
+ * オーディオスレッドはブロックごとに measureInput / measureOutput /
+ * addGainReduction で値を溜め、endBlock() で kFramesPerSecond 程度に間引いて
+ * キューに積む。コンシューマー（エディター）がいない間は isActive() が偽になり、
+ * 呼び出し側は測定ごと省く。
+ */
+class VT2BMeterTelemetry {
+public:
+  static constexpr int kFramesPerSecond = 60;
+  static constexpr size_t kQueueCapacity = 64; // 約 1 秒分
+
+  //==============================================================================
+  /** 間引きの間隔を設定する（オーディオスレッド外で呼ぶ） */
+  void prepare(double sampleRate) {
+    samplesPerFrame =
+        std::max(1, (int)std::lround(sampleRate / kFramesPerSecond));
+    clearAccumulators();
+  }
+
+  /** コンシューマーの有無（エディターの生成・破棄時に呼ぶ） */
+  void setActive(bool shouldBeActive) {
+    active.store(shouldBeActive, std::memory_order_relaxed);
+  }
+  bool isActive() const { return active.load(std::memory_order_relaxed); }
+
+  //==============================================================================
+  // オーディオスレッド側
+
+  template <typename SampleType>
+  void measureInput(const SampleType *const *channels, int numChannels,
+                    int numSamples) {
+    measure(channels, numChannels, numSamples, inputPeak, inputSquares);
+  }
+
+  template <typename SampleType>
+  void measureOutput(const SampleType *const *channels, int numChannels,
+                     int numSamples) {
+    measure(channels, numChannels, numSamples, outputPeak, outputSquares);
+  }
+
+  /** ブロック内で最も深いゲインリダクション（リニア）を渡す */
+  void addGainReduction(float gain) {
+    gainReduction = std::min(gainReduction, gain);
+  }
+
+  /** 間隔に達していればフレームを積む（キューが満杯なら捨てる） */
+  void endBlock(int numSamples) {
+    accumulatedSamples += numSamples;
+
+    if (accumulatedSamples < samplesPerFrame)
+      return;
+
+    // RMS は全チャンネルのうち最大のもの
+    const double samples = (double)accumulatedSamples;
+    double inputMeanSquare = 0.0;
+    double outputMeanSquare = 0.0;
+
+    for (size_t channel = 0; channel < kMaxChannels; ++channel) {
+      inputMeanSquare = std::max(inputMeanSquare, inputSquares[channel]);
+      outputMeanSquare = std::max(outputMeanSquare, outputSquares[channel]);
+    }
+
+    VT2BMeterFrame frame;
+    frame.inputPeak = inputPeak;
+    frame.inputRms = (float)std::sqrt(inputMeanSquare / samples);
+    frame.outputPeak = outputPeak;
+    frame.outputRms = (float)std::sqrt(outputMeanSquare / samples);
+    frame.gainReduction = gainReduction;
+
+    frames.push(frame);
+    clearAccumulators();
+  }
+
+  //==============================================================================
+  /** コンシューマー側: 次のフレームを取り出す（なければ false） */
+  bool pop(VT2BMeterFrame &frame) { return frames.pop(frame); }
+
+private:
+  static constexpr size_t kMaxChannels = 16; // VT2BGlueEngine::kMaxChannels
+
+  template <typename SampleType>
+  static void measure(const SampleType *const *channels, int numChannels,
+                      int numSamples, float &peak,
+                      std::array<double, kMaxChannels> &squares) {
+    numChannels = std::min(numChannels, (int)kMaxChannels);
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+      const SampleType *data = channels[channel];
+      float channelPeak = 0.0f;
+      float channelSquares = 0.0f;
+
+      // float で溜める（1 ブロック分なら精度は足りる）
+      for (int i = 0; i < numSamples; ++i) {
+        const float sample = (float)data[i];
+        channelPeak = std::max(channelPeak, std::abs(sample));
+        channelSquares += sample * sample;
+      }
+
+      peak = std::max(peak, channelPeak);
+      squares[(size_t)channel] += channelSquares;
+    }
+  }
+
+  void clearAccumulators() {
+    accumulatedSamples = 0;
+    inputPeak = 0.0f;
+    outputPeak = 0.0f;
+    inputSquares.fill(0.0);
+    outputSquares.fill(0.0);
+    gainReduction = 1.0f;
+  }
+
+  std::atomic<bool> active{false};
+
+  // オーディオスレッドだけが触る集計値
+  int samplesPerFrame = 800;
+  int accumulatedSamples = 0;
+  float inputPeak = 0.0f;
+  float outputPeak = 0.0f;
+  std::array<double, kMaxChannels> inputSquares{};
+  std::array<double, kMaxChannels> outputSquares{};
+  float gainReduction = 1.0f;
+
+  VT2BSpscQueue<VT2BMeterFrame, kQueueCapacity> frames;
+};
@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+    VT-2B Black - EMU AUDIO
+    Trace Events
+
+    処理の区間（ブロック全体・DSP の各段・状態の保存 / 読み込み・エディターの描画）を
+    スレッドごとに記録し、Chrome の trace event 形式（JSON）で書き出す。
+    書き出したファイルは Perfetto UI（ui.perfetto.dev）や chrome://tracing で
+    オフラインで開ける。
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// トレースの有無（-DVT2B_ENABLE_TRACING=1、CMake では EA_VT_2B_ENABLE_TRACING）。
+// 無効時はマクロが空になり、計測のコードは何も残らない
+#ifndef VT2B_ENABLE_TRACING
+#define VT2B_ENABLE_TRACING 0
+#endif
+
+//==============================================================================
+/**
+ * トレースの記録先（プロセスに 1 つ）
+ *
+ * 固定長のリングバッファで、いっぱいになると古いイベントから上書きする（グリッチの
+ * 直前の様子が残る）。記録はどのスレッドからでも良く、確保・ロックはしない。
+ * 各スロットはシーケンス番号で書き込み中かどうかを示し、書き出しは書き込み中・
+ * 上書き途中のスロットを読み飛ばす。
+ *
+ * 名前とカテゴリは文字列リテラル（ポインタだけを持つ）。JSON にはそのまま
+ * 書くので、引用符やバックスラッシュは使わないこと。
+ */
+class VT2BTraceRecorder {
+public:
+  static constexpr int kCapacity = 1 << 16; // 2 の累乗
+  static constexpr int kMaxThreads = 64;
+
+  static VT2BTraceRecorder &getInstance() {
+    static VT2BTraceRecorder instance;
+    return instance;
+  }
+
+  static int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  /** 完了した区間を 1 つ記録する */
+  void record(const char *category, const char *name, int64_t startNs,
+              int64_t endNs) {
+    const uint64_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = slots[(size_t)(index & (kCapacity - 1))];
+
+    // 奇数 = 書き込み中
+    slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(startNs, std::memory_order_relaxed);
+    slot.duration.store(endNs - startNs, std::memory_order_relaxed);
+    slot.thread.store(getThreadIndex(), std::memory_order_relaxed);
+
+    slot.sequence.store(index * 2 + 2, std::memory_order_release);
+  }
+
+  /** 呼び出し元スレッドの表示名（トレースのトラック名になる） */
+  void setThreadName(const char *name) {
+    const uint32_t thread = getThreadIndex();
+
+    if (thread < (uint32_t)kMaxThreads)
+      threadNames[thread].store(name, std::memory_order_relaxed);
+  }
+
+  /**
+   * 記録済みのイベント（最大 kCapacity 件）の JSON
+   * 文字列を組み立てるので、オーディオスレッドからは呼ばないこと。
+   */
+  std::string getJson() const {
+    std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+
+    auto appendEvent = [&](const char *format, auto... args) {
+      char line[256];
+      std::snprintf(line, sizeof(line), format, args...);
+
+      if (!first)
+        json += ",\n";
+
+      json += line;
+      first = false;
+    };
+
+    for (int thread = 0; thread < kMaxThreads; ++thread)
+      if (const char *name =
+              threadNames[(size_t)thread].load(std::memory_order_relaxed))
+        appendEvent("{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,"
+                    "\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                    thread, name);
+
+    const uint64_t end = nextIndex.load(std::memory_order_acquire);
+    const uint64_t begin = end > (uint64_t)kCapacity ? end - kCapacity : 0;
+
+    for (uint64_t index = begin; index < end; ++index) {
+      const Slot &slot = slots[(size_t)(index & (kCapacity - 1))];
+      const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+      if (sequence != index * 2 + 2)
+        continue;
+
+      const char *category = slot.category.load(std::memory_order_relaxed);
+      const char *name = slot.name.load(std::memory_order_relaxed);
+      const int64_t start = slot.start.load(std::memory_order_relaxed);
+      const int64_t duration = slot.duration.load(std::memory_order_relaxed);
+      const uint32_t thread = slot.thread.load(std::memory_order_relaxed);
+
+      // 読んでいる間に上書きされていたら捨てる
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+        continue;
+
+      appendEvent("{\"ph\":\"X\",\"cat\":\"%s\",\"name\":\"%s\",\"pid\":1,"
+                  "\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                  category, name, thread, (double)start * 1.0e-3,
+                  (double)duration * 1.0e-3);
+    }
+
+    json += "\n]}\n";
+    return json;
+  }
+
+private:
+  struct Slot {
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<const char *> category{nullptr};
+    std::atomic<const char *> name{nullptr};
+    std::atomic<int64_t> start{0};
+    std::atomic<int64_t> duration{0};
+    std::atomic<uint32_t> thread{0};
+  };
+
+  /** スレッドごとの通し番号（初回だけ割り当てる） */
+  uint32_t getThreadIndex() {
+    thread_local uint32_t index = nextThread.fetch_add(1);
+    return index;
+  }
+
+  std::array<Slot, kCapacity> slots{};
+  std::array<std::atomic<const char *>, kMaxThreads> threadNames{};
+  std::atomic<uint64_t> nextIndex{0};
+  std::atomic<uint32_t> nextThread{0};
+};
+
+//==============================================================================
+/** 区間の計測（デストラクタで記録する） */
+class VT2BTraceScope {
+public:
+  VT2BTraceScope(const char *categoryName, const char *eventName,
+                 bool shouldRecord = true)
+      : category(categoryName), name(eventName),
+        start(shouldRecord ? VT2BTraceRecorder::now() : -1) {}
+
+  ~VT2BTraceScope() {
+    if (start >= 0)
+      VT2BTraceRecorder::getInstance().record(category, name, start,
+                                              VT2BTraceRecorder::now());
+  }
+
+  VT2BTraceScope(const VT2BTraceScope &) = delete;
+  VT2BTraceScope &operator=(const VT2BTraceScope &) = delete;
+
+private:
+  const char *category;
+  const char *name;
+  int64_t start;
+};
+
+//==============================================================================
+// 計測用マクロ（カテゴリ・名前は文字列リテラル）
+#if VT2B_ENABLE_TRACING
+#define VT2B_TRACE_CONCAT_INNER(a, b) a##b
+#define VT2B_TRACE_CONCAT(a, b) VT2B_TRACE_CONCAT_INNER(a, b)
+
+/** スコープの終わりまでを 1 区間として記録する */
+#define VT2B_TRACE_SCOPE(category, name)                                       \
+  const VT2BTraceScope VT2B_TRACE_CONCAT(vt2bTraceScope, __LINE__)(category,   \
+                                                                   name)
+
+/** 条件が真のときだけ記録する（条件は無効時には評価されない） */
+#define VT2B_TRACE_SCOPE_IF(condition, category, name)                         \
+  const VT2BTraceScope VT2B_TRACE_CONCAT(vt2bTraceScope, __LINE__)(            \
+      category, name, (condition))
+
+/** 呼び出し元スレッドにトラック名を付ける */
+#define VT2B_TRACE_THREAD_NAME(name)                                           \
+  VT2BTraceRecorder::getInstance().setThreadName(name)
+#else
+#define VT2B_TRACE_SCOPE(category, name) ((void)0)
+#define VT2B_TRACE_SCOPE_IF(condition, category, name) ((void)0)
+#define VT2B_TRACE_THREAD_NAME(name) ((void)0)
+#endif